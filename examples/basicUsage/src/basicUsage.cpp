@@ -148,7 +148,8 @@ void setup()
 	EEPROM.write(myAddress + sizeof(uint16_t), 0); 
     delay(1000);
     
-	if (!mySettings.verifyChecksum());
+	// Deep check: the fault was written directly to EEPROM, bypassing the class
+	if (!mySettings.verifyChecksum(true))
 	{
 		Serial.println("\n!!!!! EEPROM Data Corrupted, Resetting to defaults.\n");
 		mySettings.reinitialize();
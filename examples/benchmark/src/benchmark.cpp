@@ -0,0 +1,398 @@
+/**
+ * @file benchmark.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Microbenchmark of the EEPROM_Class and UserSettingsClass operations across object sizes
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <Particle.h>
+
+/**
+ * @details
+ *
+ * Microbenchmark for the EEPROM_Class and UserSettingsClass operations.
+ *
+ * Times begin(), readObject(), writeObject(), verifyChecksum() (cached and deep) and the UserSettingsClass setters for a range
+ * of object sizes, and reports for each:
+ * 	- ns/op
+ * 	- EEPROM bytes read and written per op
+ * 	- cycles per byte (System ticks per object byte), for the operations whose cost grows with the object size
+ *
+ * The cost of changing one item of an encrypted object (EEPROM_SecureClass) is compared with a plaintext write.
+ *
+ * It then projects the EEPROM life of the settings storage strategies (full rewrite, sparse overlay, ring log)
+ * at CHANGES_PER_DAY, for both byte EEPROM and flash emulated EEPROM, using EEPROM_Endurance.
+ *
+ * Results are printed to Serial as one JSON object per line so they can be captured and compared between
+ * library versions. Object sizes run from 8 bytes up to the largest EEPROM (4 KB, Gen3); sizes that do not fit
+ * in the device's EEPROM are skipped. The host build (host/Makefile) runs the same sketch against the simulated
+ * EEPROM, enlarged to 128 KB, and adds 16 KB and 64 KB objects (BENCHMARK_MAX_SIZE).
+ *
+ * @note The write benchmarks wear the EEPROM. Keep WRITE_ITERATIONS small.
+ */
+
+/******************************************************************************
+ * Serial log handler
+ ******************************************************************************/
+
+//! @brief Log errors only, so that logging does not distort the timings
+SerialLogHandler logHandler(115200, LOG_LEVEL_ERROR);
+
+/******************************************************************************
+ * Class Instantiations
+ ******************************************************************************/
+#include "EEPROM_Class.h"
+#include "UserSettingsClass.h"
+#include "EEPROM_Endurance.h"
+#include "EEPROM_SecureClass.h"
+
+//! EEPROM address used for the benchmark objects
+#define BENCHMARK_ADDRESS 0
+
+//! Iterations for operations that only read EEPROM
+#define READ_ITERATIONS 100
+
+//! Iterations for operations that write EEPROM
+#define WRITE_ITERATIONS 10
+
+//! Settings changes per day assumed for the lifetime projections
+#define CHANGES_PER_DAY 24
+
+//! Rated endurance of a byte EEPROM cell
+#define EEPROM_CELL_ENDURANCE 100000
+
+//! Rated erase endurance of a flash page, and the flash emulation geometry: pages, page size, bytes per record
+#define FLASH_ENDURANCE 10000
+#define FLASH_PAGES 2
+#define FLASH_PAGE_SIZE 16384
+#define FLASH_RECORD_SIZE 4
+
+//! Slots in a wear-leveled ring log of settings
+#define RING_SLOTS 16
+
+//! Largest object benchmarked; objects above 4 KB need the host build's larger EEPROM and RAM
+#ifndef BENCHMARK_MAX_SIZE
+#define BENCHMARK_MAX_SIZE 4092
+#endif
+
+//! EEPROM size of the device modelled by the flash endurance projection
+#ifndef ENDURANCE_EEPROM_SIZE
+#define ENDURANCE_EEPROM_SIZE EEPROM.length()
+#endif
+
+/**
+ * @brief Blue Led on the Photon Module
+ *
+ */
+#define ledMain D7
+
+/******************************************************************************
+ * Benchmark helpers
+ ******************************************************************************/
+
+/**
+ * @brief Data object of a given size
+ *
+ * @tparam SIZE object size (bytes)
+ */
+template <size_t SIZE>
+struct BenchObject
+{
+	uint8_t data[SIZE];
+};
+
+/**
+ * @brief Print one benchmark result as a JSON line
+ *
+ * @param op Operation name
+ * @param size Object size (bytes)
+ * @param ticks Total system ticks for all iterations
+ * @param iterations Number of iterations
+ * @param bytesRead Total EEPROM bytes read
+ * @param bytesWritten Total EEPROM bytes written
+ * @param perByte Operation cost grows with the object size: also report cycles per byte
+ */
+void report(const char *op, size_t size, uint32_t ticks, uint32_t iterations, uint32_t bytesRead, uint32_t bytesWritten, bool perByte = false)
+{
+	double nsPerOp = (ticks * 1000.0) / System.ticksPerMicrosecond() / iterations;
+	char cyclesPerByte[32] = "";
+
+	if (perByte)
+	{
+		snprintf(cyclesPerByte, sizeof(cyclesPerByte), ",\"cycles_per_byte\":%.2f", (double)ticks / iterations / size);
+	}
+	Serial.printlnf("{\"op\":\"%s\",\"size\":%u,\"ns_per_op\":%.1f,\"read_bytes_per_op\":%.1f,\"write_bytes_per_op\":%.1f%s}",
+					op, (unsigned)size, nsPerOp, (double)bytesRead / iterations, (double)bytesWritten / iterations, cyclesPerByte);
+}
+
+/**
+ * @brief Run the EEPROM_Class benchmarks for one object size
+ *
+ * @tparam SIZE object size (bytes)
+ */
+template <size_t SIZE>
+void runBenchmark()
+{
+	static BenchObject<SIZE> object;
+	EEPROM_Class<BenchObject<SIZE> > myEEPROM;
+	uint32_t start;
+
+	if ((BENCHMARK_ADDRESS + SIZE + sizeof(uint16_t)) > EEPROM.length())
+	{
+		Serial.printlnf("{\"op\":\"skip\",\"size\":%u}", (unsigned)SIZE);
+		return;
+	}
+
+	for (size_t i = 0; i < SIZE; i++)
+	{
+		object.data[i] = i;
+	}
+	myEEPROM.begin(BENCHMARK_ADDRESS, object);
+	myEEPROM.writeObject(object);
+
+	myEEPROM.resetCounters();
+	start = System.ticks();
+	for (uint32_t i = 0; i < READ_ITERATIONS; i++)
+	{
+		myEEPROM.begin(BENCHMARK_ADDRESS, object);
+	}
+	report("begin", SIZE, System.ticks() - start, READ_ITERATIONS, myEEPROM.getBytesRead(), myEEPROM.getBytesWritten(), true);
+
+	myEEPROM.resetCounters();
+	start = System.ticks();
+	for (uint32_t i = 0; i < READ_ITERATIONS; i++)
+	{
+		myEEPROM.readObject(object);
+	}
+	report("readObject", SIZE, System.ticks() - start, READ_ITERATIONS, myEEPROM.getBytesRead(), myEEPROM.getBytesWritten(), true);
+
+	myEEPROM.resetCounters();
+	start = System.ticks();
+	for (uint32_t i = 0; i < READ_ITERATIONS; i++)
+	{
+		myEEPROM.verifyChecksum();
+	}
+	report("verifyChecksum", SIZE, System.ticks() - start, READ_ITERATIONS, myEEPROM.getBytesRead(), myEEPROM.getBytesWritten());
+
+	myEEPROM.resetCounters();
+	start = System.ticks();
+	for (uint32_t i = 0; i < READ_ITERATIONS; i++)
+	{
+		myEEPROM.verifyChecksum(true);
+	}
+	report("verifyChecksumDeep", SIZE, System.ticks() - start, READ_ITERATIONS, myEEPROM.getBytesRead(), myEEPROM.getBytesWritten(), true);
+
+	myEEPROM.resetCounters();
+	start = System.ticks();
+	for (uint32_t i = 0; i < WRITE_ITERATIONS; i++)
+	{
+		object.data[0] = i;
+		myEEPROM.writeObject(object);
+	}
+	report("writeObject", SIZE, System.ticks() - start, WRITE_ITERATIONS, myEEPROM.getBytesRead(), myEEPROM.getBytesWritten(), true);
+}
+
+/**
+ * @brief Run the UserSettingsClass setter benchmarks
+ *
+ */
+void runSettingsBenchmark()
+{
+	UserSettingsClass mySettings;
+	uint32_t start;
+
+	mySettings.begin(BENCHMARK_ADDRESS);
+
+	mySettings.resetCounters();
+	start = System.ticks();
+	for (uint32_t i = 0; i < WRITE_ITERATIONS; i++)
+	{
+		mySettings.setTimeZone(-(float)(i % 12));
+	}
+	report("setTimeZone", sizeof(SettingsObject), System.ticks() - start, WRITE_ITERATIONS, mySettings.getBytesRead(), mySettings.getBytesWritten());
+
+	mySettings.resetCounters();
+	start = System.ticks();
+	for (uint32_t i = 0; i < WRITE_ITERATIONS; i++)
+	{
+		mySettings.setHostName((i & 1) ? "BenchmarkHostA" : "BenchmarkHostB");
+	}
+	report("setHostName", sizeof(SettingsObject), System.ticks() - start, WRITE_ITERATIONS, mySettings.getBytesRead(), mySettings.getBytesWritten());
+
+	mySettings.reinitialize();
+}
+
+/**
+ * @brief Compare encrypted and plaintext writes of a single item
+ *
+ * @tparam SIZE object size (bytes)
+ */
+template <size_t SIZE>
+void runSecureBenchmark()
+{
+	typedef EEPROM_SecureClass<BenchObject<SIZE> > SecureClass;
+	static BenchObject<SIZE> object;
+	static const uint8_t key[EEPROM_Cipher::KEY_SIZE] = {0};
+	EEPROM_Class<BenchObject<SIZE> > myEEPROM;
+	SecureClass mySecure;
+	uint32_t start;
+	uint32_t blocksRead;
+	uint32_t blocksWritten;
+
+	if ((BENCHMARK_ADDRESS + mySecure.BLOCK_COUNT * mySecure.SLOT_SIZE) > EEPROM.length())
+	{
+		Serial.printlnf("{\"op\":\"skip\",\"size\":%u}", (unsigned)SIZE);
+		return;
+	}
+
+	myEEPROM.begin(BENCHMARK_ADDRESS, object);
+	myEEPROM.writeObject(object);
+	myEEPROM.resetCounters();
+	start = System.ticks();
+	for (uint32_t i = 0; i < WRITE_ITERATIONS; i++)
+	{
+		object.data[SIZE / 2] = i;
+		myEEPROM.writeObject(object);
+	}
+	report("itemWritePlain", SIZE, System.ticks() - start, WRITE_ITERATIONS, myEEPROM.getBytesRead(), myEEPROM.getBytesWritten());
+
+	mySecure.begin(BENCHMARK_ADDRESS, key);
+	mySecure.initialize(object);
+	blocksWritten = mySecure.getBlocksWritten();
+	start = System.ticks();
+	for (uint32_t i = 0; i < WRITE_ITERATIONS; i++)
+	{
+		mySecure.put(SIZE / 2, (uint8_t)(i + 1));
+	}
+	report("itemWriteSecure", SIZE, System.ticks() - start, WRITE_ITERATIONS, 0, (mySecure.getBlocksWritten() - blocksWritten) * mySecure.SLOT_SIZE);
+
+	start = System.ticks();
+	for (uint32_t i = 0; i < READ_ITERATIONS; i++)
+	{
+		SecureClass fresh;
+		uint8_t item;
+
+		fresh.begin(BENCHMARK_ADDRESS, key);
+		fresh.get(SIZE / 2, item);
+		blocksRead = fresh.getBlocksRead();
+	}
+	report("itemReadSecure", SIZE, System.ticks() - start, READ_ITERATIONS, READ_ITERATIONS * blocksRead * mySecure.SLOT_SIZE, 0);
+}
+
+/**
+ * @brief Print the projected EEPROM life of one storage strategy as a JSON line
+ *
+ * @param strategy Strategy name
+ * @param workload Workload
+ */
+void reportEndurance(const char *strategy, const EEPROM_Workload &workload)
+{
+	EEPROM_Endurance eeprom(EEPROM_CELL_ENDURANCE);
+	EEPROM_Endurance flash(FLASH_ENDURANCE, FLASH_PAGE_SIZE, FLASH_PAGES, FLASH_RECORD_SIZE, ENDURANCE_EEPROM_SIZE);
+
+	Serial.printlnf("{\"op\":\"endurance\",\"strategy\":\"%s\",\"commits_per_day\":%.1f,\"records_per_commit\":%.1f,\"footprint\":%lu,\"hottest_writes_per_commit\":%.1f,\"eeprom_years\":%.1f,\"flash_years\":%.1f}",
+					strategy, workload.commitsPerDay, workload.recordsPerCommit, (unsigned long)workload.footprint, workload.hottestWritesPerCommit,
+					eeprom.years(workload), flash.years(workload));
+}
+
+/**
+ * @brief Compare the projected EEPROM life of the settings storage strategies
+ *
+ * Records per commit are measured from the setter workload, then scaled to CHANGES_PER_DAY.
+ */
+void runEnduranceBenchmark()
+{
+	const uint32_t secondsPerChange = 86400 / CHANGES_PER_DAY;
+	UserSettingsClass fullSettings;
+	UserSettingsClass sparseSettings(true);
+	EEPROM_Workload workload;
+
+	// Full rewrite of the object on every change
+	fullSettings.begin(BENCHMARK_ADDRESS);
+	fullSettings.resetCounters();
+	for (uint32_t i = 0; i < WRITE_ITERATIONS; i++)
+	{
+		fullSettings.setTimeZone(-(float)(i % 12));
+	}
+	workload = EEPROM_Endurance::measure(fullSettings, WRITE_ITERATIONS * secondsPerChange);
+	reportEndurance("full", workload);
+
+	// The same records, rotated over the slots of a ring log, where each cell is written once per slot write
+	workload.spread = RING_SLOTS;
+	workload.hottestWritesPerCommit = 1;
+	reportEndurance("ringLog", workload);
+	fullSettings.reinitialize();
+
+	// Sparse overlay: only the chunks that differ from the defaults
+	sparseSettings.begin(BENCHMARK_ADDRESS);
+	sparseSettings.resetCounters();
+	for (uint32_t i = 0; i < WRITE_ITERATIONS; i++)
+	{
+		sparseSettings.setTimeZone(-(float)(i % 12));
+	}
+	reportEndurance("sparse", EEPROM_Endurance::measure(sparseSettings, WRITE_ITERATIONS * secondsPerChange));
+	sparseSettings.reinitialize();
+}
+
+/******************************************************************************
+ * Setup
+ ******************************************************************************/
+/**
+ * @brief Setup Function
+ *
+ * - Setup basic I/O
+ * - Run the benchmarks for each object size
+ *
+ */
+void setup()
+{
+	// Enable the onboard LED
+	pinMode(ledMain, OUTPUT);
+
+	// Setup Serial  and wait until the user acknowledges
+	Serial.begin(115200);
+	delay(5000);
+
+	Serial.print("\n***** Hit any key to start *****\n\n");
+	while (!Serial.available())
+		;
+	Serial.read();
+
+	runBenchmark<8>();
+	runBenchmark<32>();
+	runBenchmark<128>();
+	runBenchmark<512>();
+	runBenchmark<1024>();
+	runBenchmark<2044>();
+	runBenchmark<4092>();
+#if BENCHMARK_MAX_SIZE >= 65536
+	runBenchmark<16384>();
+	runBenchmark<65536>();
+#endif
+	runSettingsBenchmark();
+	runSecureBenchmark<32>();
+	runSecureBenchmark<128>();
+	runSecureBenchmark<512>();
+	runEnduranceBenchmark();
+
+	Serial.println("\n***** Benchmark Complete ***** \n");
+}
+
+/******************************************************************************
+ * loop
+ ******************************************************************************/
+/**
+ * @brief Main Loop
+ *
+ */
+void loop()
+{
+	digitalWrite(ledMain, HIGH);
+	delay(200);
+	digitalWrite(ledMain, LOW);
+	delay(800);
+}
@@ -0,0 +1,297 @@
+/**
+ * @file powerLossTest.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+
+#include <Particle.h>
+
+/**
+ * @details
+ *
+ * Power-loss torture test for UserSettingsClass updates.
+ *
+ * Each round picks an old and a new settings value. For every byte index of the update the sketch stores the old
+ * value, arms EEPROM_Fault to reset the device just before that byte is written, and makes the update. After the
+ * reset, begin() loads the settings and the result is classified as:
+ * 	- old: the previous settings were loaded
+ * 	- new: the updated settings were loaded
+ * 	- defaults: the checksum was invalid and begin() reset the settings to defaults
+ * 	- corrupt: the checksum was valid but the settings match neither value (silent corruption)
+ *
+ * The cut then moves to the next byte index. A round ends when the update completes without reaching the cut.
+ * Test state is kept in retained memory across resets, and the totals are printed after ROUNDS rounds.
+ *
+ * Must be built with EEPROM_FAULT_INJECTION defined for the whole build (e.g. EXTRA_CFLAGS=-DEEPROM_FAULT_INJECTION).
+ *
+ * @note Every trial rewrites the settings, wearing the EEPROM.
+ */
+
+#ifndef EEPROM_FAULT_INJECTION
+#error "Build with EXTRA_CFLAGS=-DEEPROM_FAULT_INJECTION"
+#endif
+
+STARTUP(System.enableFeature(FEATURE_RETAINED_MEMORY));
+
+/******************************************************************************
+ * Serial log handler
+ ******************************************************************************/
+
+//! @brief Log errors only; begin() logs an error for each reset to defaults
+SerialLogHandler logHandler(115200, LOG_LEVEL_ERROR);
+
+/******************************************************************************
+ * Class Instantiations
+ ******************************************************************************/
+#include "UserSettingsClass.h"
+
+//! EEPROM address used for the settings object
+#define myAddress 0
+
+//! Number of rounds (one update cut at every byte index per round)
+#define ROUNDS 20
+
+/**
+ * @brief Blue Led on the Photon Module
+ *
+ */
+#define ledMain D7
+
+/******************************************************************************
+ * Test state, retained across resets
+ ******************************************************************************/
+
+/**
+ * @brief Trial outcomes
+ */
+enum Outcome
+{
+	OUTCOME_OLD,
+	OUTCOME_NEW,
+	OUTCOME_DEFAULTS,
+	OUTCOME_CORRUPT,
+	OUTCOME_COUNT
+};
+
+//! @brief Outcome names
+static const char *const outcomeNames[OUTCOME_COUNT] = {"old", "new", "defaults", "corrupt"};
+
+//! @brief Marks valid retained state
+#define STATE_MAGIC 0x504C5431
+
+/**
+ * @brief Torture test state
+ */
+struct TortureState
+{
+	/** STATE_MAGIC when valid */
+	uint32_t magic;
+	/** Pseudo-random generator state */
+	uint32_t seed;
+	/** Current round */
+	uint32_t round;
+	/** Byte index of the power cut */
+	uint32_t cut;
+	/** An update was in progress */
+	bool pending;
+	/** Start time (seconds) */
+	time_t startTime;
+	/** Outcome totals */
+	uint32_t counts[OUTCOME_COUNT];
+	/** Settings before the update */
+	float oldTz;
+	/** Settings before the update */
+	char oldHost[32];
+	/** Settings after the update */
+	float newTz;
+	/** Settings after the update */
+	char newHost[32];
+};
+
+//! @brief Test state
+retained TortureState state;
+
+/******************************************************************************
+ * Test functions
+ ******************************************************************************/
+
+/**
+ * @brief Next pseudo-random number (xorshift32), reproducible from the initial seed
+ *
+ * @return uint32_t
+ */
+uint32_t nextRandom()
+{
+	state.seed ^= state.seed << 13;
+	state.seed ^= state.seed >> 17;
+	state.seed ^= state.seed << 5;
+	return state.seed;
+}
+
+/**
+ * @brief Pick new values for a round. Even rounds change the time zone, odd rounds the hostname.
+ *
+ */
+void newRound()
+{
+	state.cut = 0;
+	state.oldTz = state.newTz;
+	strcpy(state.oldHost, state.newHost);
+
+	if (state.round & 1)
+	{
+		// Random length, so that both short and long names are cut
+		size_t length = 1 + nextRandom() % (sizeof(state.newHost) - 1);
+
+		for (size_t i = 0; i < length; i++)
+		{
+			state.newHost[i] = 'a' + nextRandom() % 26;
+		}
+		state.newHost[length] = 0;
+	}
+	else
+	{
+		do
+		{
+			state.newTz = (float)(nextRandom() % 27) - 12;
+		} while (state.newTz == state.oldTz);
+	}
+}
+
+/**
+ * @brief Classify the settings loaded after a power cut
+ *
+ * @param mySettings Settings, after begin()
+ * @param valid Result of begin()
+ * @return Outcome
+ */
+Outcome classify(UserSettingsClass &mySettings, bool valid)
+{
+	if (!valid)
+	{
+		return OUTCOME_DEFAULTS;
+	}
+	if ((mySettings.getTimeZone() == state.oldTz) && (strcmp(mySettings.getHostName(), state.oldHost) == 0))
+	{
+		return OUTCOME_OLD;
+	}
+	if ((mySettings.getTimeZone() == state.newTz) && (strcmp(mySettings.getHostName(), state.newHost) == 0))
+	{
+		return OUTCOME_NEW;
+	}
+	return OUTCOME_CORRUPT;
+}
+
+/**
+ * @brief Print the outcome totals and throughput
+ *
+ */
+void report()
+{
+	uint32_t trials = 0;
+	time_t elapsed = Time.now() - state.startTime;
+
+	for (size_t i = 0; i < OUTCOME_COUNT; i++)
+	{
+		trials += state.counts[i];
+		Serial.printlnf("%-8s %lu", outcomeNames[i], (unsigned long)state.counts[i]);
+	}
+	Serial.printlnf("Power cuts: %lu in %lu s (%.2f/s)", (unsigned long)trials, (unsigned long)elapsed, elapsed ? (double)trials / elapsed : 0.0);
+}
+
+/******************************************************************************
+ * Setup
+ ******************************************************************************/
+/**
+ * @brief Setup Function
+ *
+ * - Classify the result of the previous power cut, if any
+ * - Run trials until a power cut resets the device, or all rounds are complete
+ *
+ */
+void setup()
+{
+	UserSettingsClass mySettings;
+
+	// Enable the onboard LED
+	pinMode(ledMain, OUTPUT);
+	Serial.begin(115200);
+
+	if (state.magic != STATE_MAGIC)
+	{
+		// First run: wait until the user acknowledges
+		delay(5000);
+		Serial.print("\n***** Hit any key to start *****\n\n");
+		while (!Serial.available())
+			;
+		Serial.read();
+
+		memset(&state, 0, sizeof(state));
+		state.seed = 0x12345678;
+		state.startTime = Time.now();
+		state.newTz = UserSettingsClass::defaultSettings.timeZone;
+		strcpy(state.newHost, UserSettingsClass::defaultSettings.hostName);
+		newRound();
+		state.magic = STATE_MAGIC;
+	}
+
+	bool valid = mySettings.begin(myAddress);
+
+	if (state.pending)
+	{
+		Outcome outcome = classify(mySettings, valid);
+
+		state.counts[outcome]++;
+		state.pending = false;
+		Serial.printlnf("round %lu cut %lu: %s", (unsigned long)state.round, (unsigned long)state.cut, outcomeNames[outcome]);
+		state.cut++;
+	}
+
+	while (state.round < ROUNDS)
+	{
+		// Store the old settings, then cut power during the update
+		mySettings.setTimeZone(state.oldTz);
+		mySettings.setHostName(state.oldHost);
+
+		state.pending = true;
+		EEPROM_Fault::arm(state.cut);
+		if (state.round & 1)
+		{
+			mySettings.setHostName(state.newHost);
+		}
+		else
+		{
+			mySettings.setTimeZone(state.newTz);
+		}
+		EEPROM_Fault::disarm();
+		state.pending = false;
+
+		// The update completed before the cut: every byte index has been tried
+		Serial.printlnf("round %lu complete, %lu bytes per update", (unsigned long)state.round, (unsigned long)EEPROM_Fault::getBytesWritten());
+		state.round++;
+		newRound();
+	}
+
+	Serial.println("\n***** Power Loss Test Complete ***** \n");
+	report();
+}
+
+/******************************************************************************
+ * loop
+ ******************************************************************************/
+/**
+ * @brief Main Loop
+ *
+ */
+void loop()
+{
+	digitalWrite(ledMain, HIGH);
+	delay(200);
+	digitalWrite(ledMain, LOW);
+	delay(800);
+}
@@ -0,0 +1,292 @@
+/**
+ * @file Particle.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Host (Linux) stand-in for the parts of the Particle Device OS API used by the library
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include "Particle.h"
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+Logger Log;
+SerialClass Serial;
+SystemClass System;
+TimeClass Time;
+WiFiClass WiFi;
+thread_local EEPROMClass EEPROM;
+
+/******************************************************************************
+ * Logging
+ ******************************************************************************/
+
+void Logger::_write(LogLevel level, const char *format, va_list args)
+{
+	static const char *names[] = {"TRACE", "INFO", "WARN", "ERROR", "PANIC"};
+
+	if (level < _level)
+	{
+		return;
+	}
+	fprintf(stderr, "%s: ", names[(level < LOG_LEVEL_INFO) ? 0 : (level < LOG_LEVEL_WARN) ? 1 : (level < LOG_LEVEL_ERROR) ? 2 : (level < LOG_LEVEL_PANIC) ? 3 : 4]);
+	vfprintf(stderr, format, args);
+	fputc('\n', stderr);
+}
+
+#define LOGGER_FUNCTION(name, level)          \
+	void Logger::name(const char *format, ...) \
+	{                                          \
+		va_list args;                          \
+		va_start(args, format);                \
+		_write(level, format, args);           \
+		va_end(args);                          \
+	}
+
+LOGGER_FUNCTION(trace, LOG_LEVEL_TRACE)
+LOGGER_FUNCTION(info, LOG_LEVEL_INFO)
+LOGGER_FUNCTION(warn, LOG_LEVEL_WARN)
+LOGGER_FUNCTION(error, LOG_LEVEL_ERROR)
+
+void Logger::log(LogLevel level, const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	_write(level, format, args);
+	va_end(args);
+}
+
+/******************************************************************************
+ * Print
+ ******************************************************************************/
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+	size_t written = 0;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		written += write(buffer[i]);
+	}
+	return written;
+}
+
+size_t Print::_vprintf(bool newline, const char *format, va_list args)
+{
+	char buffer[512];
+	va_list copy;
+
+	va_copy(copy, args);
+	int length = vsnprintf(buffer, sizeof(buffer), format, copy);
+	va_end(copy);
+	if (length < 0)
+	{
+		return 0;
+	}
+	if ((size_t)length < sizeof(buffer))
+	{
+		write(reinterpret_cast<const uint8_t *>(buffer), length);
+	}
+	else
+	{
+		std::vector<char> large(length + 1);
+		vsnprintf(large.data(), large.size(), format, args);
+		write(reinterpret_cast<const uint8_t *>(large.data()), length);
+	}
+	return length + (newline ? print("\r\n") : 0);
+}
+
+size_t Print::printf(const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	size_t length = _vprintf(false, format, args);
+	va_end(args);
+	return length;
+}
+
+size_t Print::printlnf(const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	size_t length = _vprintf(true, format, args);
+	va_end(args);
+	return length;
+}
+
+/******************************************************************************
+ * Timing and system
+ ******************************************************************************/
+
+static const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+uint32_t millis()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+uint32_t micros()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+uint32_t SystemClass::ticks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return (uint32_t)__rdtsc();
+#else
+	return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+#endif
+}
+
+uint32_t SystemClass::ticksPerMicrosecond()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	// Calibrate the TSC against the monotonic clock over 20ms, once
+	static uint32_t rate = 0;
+
+	if (rate == 0)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		uint64_t startTicks = __rdtsc();
+		while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(20))
+			;
+		uint64_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+		rate = std::max<uint64_t>(1, (__rdtsc() - startTicks + elapsed / 2) / elapsed);
+	}
+	return rate;
+#else
+	return 1000;
+#endif
+}
+
+uint32_t HAL_RNG_GetRandomNumber(void)
+{
+	static thread_local std::mt19937 generator(std::random_device{}());
+	return generator();
+}
+
+/******************************************************************************
+ * Simulated EEPROM
+ ******************************************************************************/
+
+void EEPROMClass::resize(size_t length)
+{
+	_memory.assign(length, 0xFF);
+	_cellWrites.assign(length, 0);
+	_cellChanges.assign(length, 0);
+	_cutArmed = false;
+	setFlashModel(_flash);
+}
+
+void EEPROMClass::resetCounters()
+{
+	_reads = 0;
+	_writes = 0;
+	std::fill(_cellWrites.begin(), _cellWrites.end(), 0);
+	std::fill(_cellChanges.begin(), _cellChanges.end(), 0);
+	_recordsAppended = 0;
+	_pageErases = 0;
+}
+
+void EEPROMClass::setFlashModel(const HostFlashGeometry &geometry)
+{
+	_flash = geometry;
+	_liveRecords.clear();
+	_liveCount = 0;
+	_pageFree = 0;
+	if (_flash.recordSize != 0)
+	{
+		_liveRecords.assign((_memory.size() + _flash.recordSize - 1) / _flash.recordSize, false);
+		_pageFree = _flash.pageSize / (_flash.recordSize + _flash.recordOverhead);
+		if (_pageFree <= _liveRecords.size())
+		{
+			throw std::invalid_argument("flash page cannot hold every record of the EEPROM");
+		}
+	}
+}
+
+void EEPROMClass::_readBytes(size_t address, void *data, size_t length)
+{
+	if (address + length > _memory.size())
+	{
+		throw std::out_of_range("EEPROM read beyond the end");
+	}
+	_reads += length;
+	memcpy(data, &_memory[address], length);
+}
+
+void EEPROMClass::_writeBytes(size_t address, const void *data, size_t length)
+{
+	const uint8_t *bytes = static_cast<const uint8_t *>(data);
+
+	if (address + length > _memory.size())
+	{
+		throw std::out_of_range("EEPROM write beyond the end");
+	}
+
+	// A power cut lands inside this write: keep the bytes before it, then unwind
+	bool cut = _cutArmed && (_countdown < length);
+	size_t count = cut ? _countdown : length;
+
+	if ((_flash.recordSize != 0) && (count != 0))
+	{
+		_appendRecords(address, count, bytes);
+	}
+	for (size_t i = 0; i < count; i++)
+	{
+		_cellWrites[address + i]++;
+		if (_memory[address + i] != bytes[i])
+		{
+			_cellChanges[address + i]++;
+			_memory[address + i] = bytes[i];
+		}
+	}
+	_writes += count;
+
+	if (_cutArmed)
+	{
+		_countdown -= count;
+		if (cut)
+		{
+			_cutArmed = false;
+			throw HostPowerCut();
+		}
+	}
+}
+
+void EEPROMClass::_appendRecords(size_t address, size_t length, const uint8_t *data)
+{
+	size_t first = address / _flash.recordSize;
+	size_t last = (address + length - 1) / _flash.recordSize;
+
+	for (size_t record = first; record <= last; record++)
+	{
+		size_t start = std::max(address, record * _flash.recordSize);
+		size_t end = std::min(address + length, (record + 1) * _flash.recordSize);
+		if (_flash.skipUnchanged && (memcmp(data + (start - address), &_memory[start], end - start) == 0))
+		{
+			continue;
+		}
+
+		if (!_liveRecords[record])
+		{
+			_liveRecords[record] = true;
+			_liveCount++;
+		}
+		if (_pageFree == 0)
+		{
+			// Compact: copy the live records to an erased page
+			_pageErases++;
+			_pageFree = _flash.pageSize / (_flash.recordSize + _flash.recordOverhead) - _liveCount;
+		}
+		_pageFree--;
+		_recordsAppended++;
+	}
+}
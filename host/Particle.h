@@ -0,0 +1,436 @@
+/**
+ * @file Particle.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Host (Linux) stand-in for the parts of the Particle Device OS API used by the library
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/**
+ * @details
+ *
+ * Only what the library sources and examples use is provided, with the same signatures as Device OS, so that
+ * the library compiles unchanged for host tools, tests and benchmarks (see host/README.md). The parts that
+ * matter for measurements are modelled:
+ * 	- EEPROM is a simulated byte array that counts reads and writes, keeps per-cell wear counts, can model
+ * 	  the page erases of flash-emulated EEPROM, and can cut power at a chosen byte write.
+ * 	- millis(), micros() and System.ticks() run from the host's monotonic clock.
+ * 	- Log is silent unless a level is set with Log.setLevel(), so that logging does not distort timings.
+ *
+ * EEPROM is thread-local, so every thread of a host tool simulates its own device.
+ */
+
+using std::min;
+using std::max;
+
+/******************************************************************************
+ * Logging
+ ******************************************************************************/
+
+/**
+ * @brief Log levels (values as in Device OS)
+ */
+typedef enum
+{
+	LOG_LEVEL_ALL = 1,
+	LOG_LEVEL_TRACE = 1,
+	LOG_LEVEL_INFO = 30,
+	LOG_LEVEL_WARN = 40,
+	LOG_LEVEL_ERROR = 50,
+	LOG_LEVEL_PANIC = 60,
+	LOG_LEVEL_NONE = 70
+} LogLevel;
+
+/**
+ * @brief Logger writing to stderr
+ *
+ * Formats are not checked: the library passes size_t to %d and %u, which is correct on the 32-bit devices only.
+ */
+class Logger
+{
+public:
+	/**
+	 * @brief Set the lowest level written, LOG_LEVEL_NONE (the default) for none
+	 *
+	 * @param level log level
+	 */
+	void setLevel(LogLevel level) { _level = level; }
+
+	void log(LogLevel level, const char *format, ...);
+	void trace(const char *format, ...);
+	void info(const char *format, ...);
+	void warn(const char *format, ...);
+	void error(const char *format, ...);
+
+private:
+	void _write(LogLevel level, const char *format, va_list args);
+
+	LogLevel _level = LOG_LEVEL_NONE;
+};
+
+extern Logger Log;
+
+/**
+ * @brief Log handler: sets the level of the host logger
+ */
+class SerialLogHandler
+{
+public:
+	SerialLogHandler(int baud, LogLevel level) { (void)baud; Log.setLevel(level); }
+};
+
+/******************************************************************************
+ * Print, String and Serial
+ ******************************************************************************/
+
+/**
+ * @brief Base class for character output
+ */
+class Print
+{
+public:
+	virtual ~Print() {}
+	virtual size_t write(uint8_t c) = 0;
+	virtual size_t write(const uint8_t *buffer, size_t size);
+
+	size_t print(const char *text) { return write(reinterpret_cast<const uint8_t *>(text), strlen(text)); }
+	size_t println(const char *text = "") { return print(text) + print("\r\n"); }
+	size_t printf(const char *format, ...);
+	size_t printlnf(const char *format, ...);
+
+private:
+	size_t _vprintf(bool newline, const char *format, va_list args);
+};
+
+/**
+ * @brief Minimal Wiring String
+ */
+class String
+{
+public:
+	String(const char *text = "") : _text(text) {}
+	unsigned int length() const { return _text.length(); }
+	const char *c_str() const { return _text.c_str(); }
+
+private:
+	std::string _text;
+};
+
+/**
+ * @brief Serial port writing to stdout; input is always available, so "press any key" prompts do not block
+ */
+class SerialClass : public Print
+{
+public:
+	void begin(int baud) { (void)baud; }
+	int available() { return 1; }
+	int read() { return '\n'; }
+	size_t write(uint8_t c) { return fputc(c, stdout) == EOF ? 0 : 1; }
+	size_t write(const uint8_t *buffer, size_t size) { return fwrite(buffer, 1, size, stdout); }
+};
+
+extern SerialClass Serial;
+
+/******************************************************************************
+ * Timing and system
+ ******************************************************************************/
+
+/**
+ * @brief Milliseconds since the program started
+ */
+uint32_t millis();
+
+/**
+ * @brief Microseconds since the program started
+ */
+uint32_t micros();
+
+/**
+ * @brief Delay; returns immediately, host programs are not paced
+ */
+inline void delay(uint32_t ms) { (void)ms; }
+
+/**
+ * @brief Thrown by System.reset(), so that a host program can "reboot" the simulated device
+ */
+struct HostReset
+{
+};
+
+#define FEATURE_RETAINED_MEMORY 1
+
+/**
+ * @brief System functions
+ */
+class SystemClass
+{
+public:
+	/**
+	 * @brief CPU cycle counter (TSC on x86, nanoseconds elsewhere)
+	 */
+	uint32_t ticks();
+
+	/**
+	 * @brief Ticks per microsecond, calibrated on first use
+	 */
+	uint32_t ticksPerMicrosecond();
+
+	/**
+	 * @brief Reset the device: throws HostReset
+	 */
+	void reset() { throw HostReset(); }
+
+	void enableFeature(int feature) { (void)feature; }
+};
+
+extern SystemClass System;
+
+/**
+ * @brief Time functions
+ */
+class TimeClass
+{
+public:
+	time_t now() { return ::time(NULL); }
+	void zone(float offset) { _zone = offset; }
+	void setDSTOffset(float offset) { _dstOffset = offset; }
+	void beginDST() { _dst = true; }
+	void endDST() { _dst = false; }
+
+private:
+	float _zone = 0;
+	float _dstOffset = 1;
+	bool _dst = false;
+};
+
+extern TimeClass Time;
+
+#define retained
+#define STARTUP(code) static int _startup_ = ((code), 0)
+
+/******************************************************************************
+ * GPIO and WiFi
+ ******************************************************************************/
+
+#define OUTPUT 1
+#define HIGH 1
+#define LOW 0
+#define D7 7
+
+inline void pinMode(int pin, int mode) { (void)pin; (void)mode; }
+inline void digitalWrite(int pin, int value) { (void)pin; (void)value; }
+
+/**
+ * @brief Antenna selection (values as in Device OS)
+ */
+typedef enum
+{
+	ANT_INTERNAL = 0,
+	ANT_EXTERNAL = 1,
+	ANT_AUTO = 3,
+	ANT_NONE = 0xFF
+} WLanSelectAntenna_TypeDef;
+
+/**
+ * @brief WiFi functions
+ */
+class WiFiClass
+{
+public:
+	void setHostname(const char *name) { (void)name; }
+	void selectAntenna(WLanSelectAntenna_TypeDef antenna) { (void)antenna; }
+};
+
+extern WiFiClass WiFi;
+
+/******************************************************************************
+ * Simulated EEPROM
+ ******************************************************************************/
+
+/**
+ * @brief Thrown by the simulated EEPROM when power is cut (see EEPROMClass::cutAfter())
+ */
+struct HostPowerCut
+{
+};
+
+/**
+ * @brief Flash emulation geometry for EEPROMClass::setFlashModel()
+ */
+struct HostFlashGeometry
+{
+	/** Data bytes per emulation record */
+	size_t recordSize;
+	/** Flash page size (bytes) */
+	size_t pageSize;
+	/** Per-record overhead in flash: record number and status (bytes) */
+	size_t recordOverhead;
+	/** Skip records whose contents a write does not change (otherwise every record a write overlaps is appended) */
+	bool skipUnchanged;
+};
+
+/**
+ * @brief Simulated EEPROM
+ *
+ * Byte-addressed, initially erased (0xFF). put() writes its bytes in address order, as EEPROM.put() does.
+ *
+ * Besides the read and write counts, the simulation keeps:
+ * 	- per-cell counts of byte writes, and of byte writes that changed the cell
+ * 	- with setFlashModel(), the page erases of flash-emulated EEPROM: every write appends one record for each
+ * 	  record it overlaps (or only those it changes) to the active page, and a full page is compacted (live
+ * 	  records copied to an erased page)
+ * 	- with cutAfter(), a power cut: the selected byte write and all that follow are dropped, and HostPowerCut is
+ * 	  thrown to unwind the code under test
+ */
+class EEPROMClass
+{
+public:
+	EEPROMClass() { resize(4096); }
+
+	/**
+	 * @brief Set the EEPROM size, erasing it and clearing all counters
+	 *
+	 * @param length size (bytes)
+	 */
+	void resize(size_t length);
+
+	/**
+	 * @brief Erase the EEPROM (all bytes 0xFF) without counting writes
+	 */
+	void erase() { std::fill(_memory.begin(), _memory.end(), 0xFF); }
+
+	size_t length() { return _memory.size(); }
+
+	uint8_t read(int address)
+	{
+		_reads++;
+		return _memory.at(address);
+	}
+
+	void write(int address, uint8_t value)
+	{
+		_writeBytes(address, &value, 1);
+	}
+
+	template <typename T>
+	T &get(int address, T &value)
+	{
+		_readBytes(address, &value, sizeof(T));
+		return value;
+	}
+
+	template <typename T>
+	const T &put(int address, const T &value)
+	{
+		_writeBytes(address, &value, sizeof(T));
+		return value;
+	}
+
+	/**
+	 * @brief Read a block, as HAL_EEPROM_Get()
+	 */
+	void _readBytes(size_t address, void *data, size_t length);
+
+	/**
+	 * @brief Write a block in address order, as HAL_EEPROM_Put()
+	 */
+	void _writeBytes(size_t address, const void *data, size_t length);
+
+	/**
+	 * @brief Direct access to the memory, not counted (for test setup and inspection)
+	 */
+	uint8_t *data() { return _memory.data(); }
+
+	/**
+	 * @brief Cut power before the n'th following byte write
+	 *
+	 * @param bytes byte writes allowed before the cut
+	 */
+	void cutAfter(uint32_t bytes)
+	{
+		_countdown = bytes;
+		_cutArmed = true;
+	}
+
+	/**
+	 * @brief Cancel a pending power cut
+	 */
+	void restorePower() { _cutArmed = false; }
+
+	/**
+	 * @brief Model the page erases of flash-emulated EEPROM
+	 *
+	 * @param geometry flash geometry, recordSize 0 to disable the model
+	 */
+	void setFlashModel(const HostFlashGeometry &geometry);
+
+	/**
+	 * @brief Clear the access, wear and erase counters
+	 */
+	void resetCounters();
+
+	uint64_t getReads() { return _reads; }
+	uint64_t getWrites() { return _writes; }
+	uint64_t getPageErases() { return _pageErases; }
+	uint64_t getRecordsAppended() { return _recordsAppended; }
+
+	/**
+	 * @brief Byte writes to each cell since the last resetCounters()
+	 */
+	const std::vector<uint32_t> &getCellWrites() { return _cellWrites; }
+
+	/**
+	 * @brief Byte writes that changed each cell since the last resetCounters()
+	 */
+	const std::vector<uint32_t> &getCellChanges() { return _cellChanges; }
+
+private:
+	void _appendRecords(size_t address, size_t length, const uint8_t *data);
+
+	std::vector<uint8_t> _memory;
+	std::vector<uint32_t> _cellWrites;
+	std::vector<uint32_t> _cellChanges;
+	uint64_t _reads = 0;
+	uint64_t _writes = 0;
+
+	uint32_t _countdown = 0;
+	bool _cutArmed = false;
+
+	HostFlashGeometry _flash = {0, 0, 0, false};
+	std::vector<bool> _liveRecords;
+	size_t _liveCount = 0;
+	size_t _pageFree = 0;
+	uint64_t _recordsAppended = 0;
+	uint64_t _pageErases = 0;
+};
+
+extern thread_local EEPROMClass EEPROM;
+
+/**
+ * @brief Bulk EEPROM read (Device OS HAL)
+ */
+inline void HAL_EEPROM_Get(uint32_t address, void *data, size_t length) { EEPROM._readBytes(address, data, length); }
+
+/**
+ * @brief Bulk EEPROM write (Device OS HAL)
+ */
+inline void HAL_EEPROM_Put(uint32_t address, const void *data, size_t length) { EEPROM._writeBytes(address, data, length); }
+
+/**
+ * @brief Hardware random number (Device OS HAL)
+ */
+uint32_t HAL_RNG_GetRandomNumber(void);
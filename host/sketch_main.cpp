@@ -0,0 +1,28 @@
+/**
+ * @file sketch_main.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Host entry point for a Device OS sketch: runs setup() once
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+
+//! @brief Simulated EEPROM size for the sketch (bytes)
+#ifndef HOST_EEPROM_SIZE
+#define HOST_EEPROM_SIZE 4096
+#endif
+
+void setup();
+
+/**
+ * @brief Run the sketch's setup(). loop() is not run: host sketches do their work in setup().
+ */
+int main()
+{
+	EEPROM.resize(HOST_EEPROM_SIZE);
+	setup();
+	return 0;
+}
@@ -0,0 +1,31 @@
+/**
+ * @file check.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Minimal assertions for the host tests
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief Fail the test (exit status 1) if the condition is false
+ */
+#define CHECK(condition)                                                             \
+	do                                                                               \
+	{                                                                                \
+		if (!(condition))                                                            \
+		{                                                                            \
+			fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+			exit(1);                                                                 \
+		}                                                                            \
+	} while (0)
+
+/**
+ * @brief Report the test as passed
+ */
+#define PASS() printf("%s: passed\n", __FILE__)
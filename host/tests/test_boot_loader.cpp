@@ -0,0 +1,153 @@
+/**
+ * @file test_boot_loader.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Boot loader: batched defaults, objects larger than the buffer, read counters, power cuts in the batch
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include "EEPROM_BootLoader.h"
+#include "UserSettingsClass.h"
+#include "check.h"
+
+struct Item
+{
+	uint8_t data[200];
+};
+
+//! @brief Defaults of the plain object
+static const Item itemDefaults = {{1, 2, 3, 4, 5}};
+
+/**
+ * @brief The objects of one boot: full and sparse settings and a plain object, adjacent in EEPROM
+ */
+struct Boot
+{
+	UserSettingsClass full;
+	UserSettingsClass sparse;
+	EEPROM_Class<Item> plain;
+	Item item;
+	EEPROM_BootLoader loader;
+
+	Boot() : sparse(true)
+	{
+		memset(&item, 0, sizeof(item));
+		plain.setDefaults(itemDefaults);
+		full.attach(0);
+		sparse.attach(full.getSize());
+		plain.attach(full.getSize() + sparse.getSize(), item);
+		loader.add(full);
+		loader.add(sparse);
+		loader.add(plain);
+	}
+
+	bool load(size_t length)
+	{
+		uint8_t buffer[512];
+		return loader.load(buffer, min(length, sizeof(buffer)));
+	}
+
+	bool isDefault()
+	{
+		return (memcmp(&item, &itemDefaults, sizeof(item)) == 0) && (full.getTimeZone() == DEFAULT_USER_TZ) &&
+			   (strcmp(sparse.getHostName(), DEFAULT_USER_HOSTNAME) == 0);
+	}
+};
+
+int main()
+{
+	const HostFlashGeometry flash = {16, 8192, 0, false};
+	uint64_t separateRecords;
+	uint64_t batchedRecords;
+
+	// Defaults written object by object, for comparison
+	EEPROM.resize(4096);
+	EEPROM.setFlashModel(flash);
+	{
+		Boot boot;
+		EEPROM.resetCounters();
+		CHECK(boot.full.loadDefaults());
+		CHECK(boot.sparse.loadDefaults());
+		CHECK(boot.plain.loadDefaults());
+		separateRecords = EEPROM.getRecordsAppended();
+	}
+
+	// Erased EEPROM: all invalid, defaults batched, then valid on the next boot
+	EEPROM.resize(4096);
+	EEPROM.setFlashModel(flash);
+	{
+		Boot boot;
+		EEPROM.resetCounters();
+		CHECK(!boot.load(512));
+		batchedRecords = EEPROM.getRecordsAppended();
+		CHECK(boot.isDefault());
+		CHECK(boot.full.verifyChecksum(true));
+		CHECK(boot.sparse.verifyChecksum(true));
+		CHECK(boot.plain.verifyChecksum(true));
+		CHECK(boot.full.getWriteCount() == 1);
+		CHECK(boot.full.getBytesRead() >= boot.full.getSize());
+	}
+	CHECK(batchedRecords < separateRecords);
+	{
+		Boot boot;
+		CHECK(boot.load(512));
+		CHECK(boot.isDefault());
+		CHECK(boot.plain.getBytesRead() == boot.plain.getSize());
+		CHECK(boot.plain.getWriteCount() == 0);
+	}
+
+	// Buffer smaller than the plain object: it is loaded directly, not skipped
+	{
+		Boot boot;
+		CHECK(boot.plain.getSize() > boot.full.getSize() + boot.sparse.getSize());
+		CHECK(boot.load(boot.full.getSize() + boot.sparse.getSize()));
+		CHECK(memcmp(&boot.item, &itemDefaults, sizeof(boot.item)) == 0);
+		CHECK(boot.plain.getBytesRead() > 0);
+	}
+	{
+		// ... and reset to defaults on its own if invalid
+		Boot boot;
+		EEPROM.data()[boot.plain.getAddress() + 5] ^= 0x10;
+		CHECK(!boot.load(boot.full.getSize() + boot.sparse.getSize()));
+		CHECK(memcmp(&boot.item, &itemDefaults, sizeof(boot.item)) == 0);
+		CHECK(boot.plain.verifyChecksum(true));
+	}
+
+	// Power cut at every byte of the batch: each object is then either invalid or holds its defaults
+	EEPROM.resize(4096);
+	uint32_t bytes;
+	{
+		Boot boot;
+		EEPROM.resetCounters();
+		boot.load(512);
+		bytes = EEPROM.getWrites();
+	}
+	for (uint32_t cut = 0; cut < bytes; cut++)
+	{
+		EEPROM.erase();
+		{
+			Boot boot;
+			EEPROM.cutAfter(cut);
+			try
+			{
+				boot.load(512);
+			}
+			catch (HostPowerCut &)
+			{
+			}
+			EEPROM.restorePower();
+		}
+
+		Boot boot;
+		Item item;
+		SettingsObject settings;
+		CHECK(!boot.plain.begin(boot.plain.getAddress(), item) || (memcmp(&item, &itemDefaults, sizeof(item)) == 0));
+		CHECK(!boot.full.readObject(settings) || (memcmp(&settings, &UserSettingsClass::defaultSettings, sizeof(settings)) == 0));
+	}
+
+	PASS();
+	return 0;
+}
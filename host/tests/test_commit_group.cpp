@@ -0,0 +1,174 @@
+/**
+ * @file test_commit_group.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Commit group: atomic commits under power loss at every byte, member lifetime
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include "EEPROM_Class.h"
+#include "EEPROM_CommitGroup.h"
+#include "check.h"
+
+struct Config
+{
+	uint32_t value;
+	char name[12];
+};
+
+struct Calibration
+{
+	float gain[6];
+};
+
+//! @brief EEPROM addresses: group, then the two members
+#define GROUP_ADDRESS 0
+#define CONFIG_ADDRESS 200
+#define CALIBRATION_ADDRESS 300
+
+/**
+ * @brief Objects of one "boot" of the simulated device
+ */
+struct Device
+{
+	EEPROM_CommitGroup group;
+	EEPROM_Class<Config> configImage;
+	EEPROM_Class<Calibration> calibrationImage;
+	Config config;
+	Calibration calibration;
+	bool rolledBack;
+	bool valid;
+
+	Device()
+	{
+		rolledBack = !group.begin(GROUP_ADDRESS);
+		group.join(configImage);
+		group.join(calibrationImage);
+		valid = configImage.begin(CONFIG_ADDRESS, config);
+		valid &= calibrationImage.begin(CALIBRATION_ADDRESS, calibration);
+	}
+
+	void set(uint32_t generation)
+	{
+		config.value = generation;
+		snprintf(config.name, sizeof(config.name), "gen-%u", (unsigned)generation);
+		for (int i = 0; i < 6; i++)
+		{
+			calibration.gain[i] = generation + i / 10.0f;
+		}
+		configImage.writeObject(config);
+		calibrationImage.writeObject(calibration);
+	}
+
+	bool matches(uint32_t generation)
+	{
+		return (config.value == generation) && (calibration.gain[5] == generation + 5 / 10.0f);
+	}
+};
+
+int main()
+{
+	uint32_t cuts = 0;
+	uint32_t rolledBack = 0;
+
+	// Initial commit
+	{
+		Device device;
+		CHECK(!device.valid);
+		device.set(1);
+		CHECK(device.group.commit() == 2);
+		CHECK(device.group.verify());
+		CHECK(device.group.getSize() > device.configImage.getSize() + device.calibrationImage.getSize());
+		CHECK(GROUP_ADDRESS + device.group.getSize() <= CONFIG_ADDRESS);
+	}
+
+	// Cut power at every byte of a commit of both members: after the next boot both are old, or both new
+	for (uint32_t cut = 0;; cut++)
+	{
+		bool completed = true;
+		{
+			Device device;
+			CHECK(device.valid && device.group.verify());
+			CHECK(device.matches(1));
+			device.set(2);
+			EEPROM.cutAfter(cut);
+			try
+			{
+				device.group.commit();
+			}
+			catch (HostPowerCut &)
+			{
+				completed = false;
+			}
+			EEPROM.restorePower();
+		}
+		{
+			Device device;
+			CHECK(device.valid);
+			CHECK(device.group.verify());
+			CHECK(device.matches(1) || device.matches(2));
+			CHECK(!device.rolledBack || device.matches(1));
+			rolledBack += device.rolledBack;
+
+			// Restore generation 1 for the next cut
+			device.set(1);
+			device.group.commit();
+		}
+		if (completed)
+		{
+			break;
+		}
+		cuts++;
+	}
+	CHECK(cuts > 100);
+	CHECK(rolledBack > 0);
+	printf("%u power cuts, %u commits rolled back, none mixed\n", (unsigned)cuts, (unsigned)rolledBack);
+
+	// A destroyed member leaves its group
+	{
+		EEPROM_CommitGroup group;
+		EEPROM_Class<Config> kept;
+		Config config = {7, "kept"};
+
+		group.begin(GROUP_ADDRESS);
+		group.join(kept);
+		kept.begin(CONFIG_ADDRESS, config);
+		size_t size = group.getSize();
+		{
+			EEPROM_Class<Config> temporary;
+			group.join(temporary);
+			temporary.begin(400, config);
+			temporary.writeObject(config);
+			CHECK(group.getSize() > size);
+		}
+		CHECK(group.getSize() == size);
+		kept.writeObject(config);
+		CHECK(group.commit() == 1);
+
+		// leave(): writes the pending update, later writes are immediate
+		config.value = 8;
+		kept.writeObject(config);
+		CHECK(kept.isPending());
+		group.leave(kept);
+		CHECK(!kept.isPending());
+		CHECK(group.getSize() == size - sizeof(uint16_t) * 2 - kept.getSize());
+	}
+
+	// A destroyed group releases its members
+	EEPROM_Class<Config> member;
+	{
+		EEPROM_CommitGroup group;
+		group.begin(GROUP_ADDRESS);
+		group.join(member);
+	}
+	Config config = {9, "free"};
+	member.begin(CONFIG_ADDRESS, config);
+	member.writeObject(config);
+	CHECK(!member.isPending());
+
+	PASS();
+	return 0;
+}
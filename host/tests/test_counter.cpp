@@ -0,0 +1,135 @@
+/**
+ * @file test_counter.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Persistent counter: power cut at every byte write of roll-ups and resets
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include "EEPROM_Counter.h"
+#include "check.h"
+
+static const uint16_t COUNTER_ADDRESS = 10;
+static const size_t REGION_SIZE = 8;
+
+/**
+ * @brief Load the counter as after a reboot
+ *
+ * @return uint32_t count loaded
+ */
+static uint32_t reboot()
+{
+	EEPROM_Counter counter(REGION_SIZE);
+
+	CHECK(counter.begin(COUNTER_ADDRESS));
+	return counter.getCount();
+}
+
+int main()
+{
+	// Erased EEPROM: reset to 0
+	{
+		EEPROM_Counter counter(REGION_SIZE);
+
+		EEPROM.resize(256);
+		CHECK(!counter.begin(COUNTER_ADDRESS));
+		CHECK(counter.getCount() == 0);
+		CHECK(reboot() == 0);
+	}
+
+	// Count through several roll-ups, alternating slots
+	{
+		EEPROM_Counter counter(REGION_SIZE);
+
+		CHECK(counter.begin(COUNTER_ADDRESS));
+		for (uint32_t i = 1; i <= 5 * REGION_SIZE * 8 + 3; i++)
+		{
+			CHECK(counter.increment() == i);
+			CHECK(reboot() == i);
+		}
+	}
+
+	// Cut power at every byte write of the increment that fills the region, over several roll-ups
+	uint32_t cuts = 0;
+
+	for (int rollUp = 0; rollUp < 4; rollUp++)
+	{
+		for (uint32_t cut = 0;; cut++)
+		{
+			EEPROM_Counter counter(REGION_SIZE);
+			std::vector<uint8_t> saved;
+			uint32_t before;
+			bool cutHappened = false;
+
+			counter.begin(COUNTER_ADDRESS);
+			while (((counter.getCount() + 1) % (REGION_SIZE * 8)) != 0)
+			{
+				counter.increment();
+			}
+			before = counter.getCount();
+			saved.assign(EEPROM.data(), EEPROM.data() + EEPROM.length());
+
+			EEPROM.cutAfter(cut);
+			try
+			{
+				counter.increment();
+			}
+			catch (HostPowerCut &)
+			{
+				cutHappened = true;
+			}
+			EEPROM.restorePower();
+
+			uint32_t after = reboot();
+			CHECK(after == (cut == 0 ? before : before + 1));
+			// Booting again after finishing the roll-up changes nothing
+			CHECK(reboot() == after);
+			if (!cutHappened)
+			{
+				break;
+			}
+			cuts++;
+			if (rollUp < 3)
+			{
+				// Retry the next cut point from the same state
+				memcpy(EEPROM.data(), saved.data(), saved.size());
+			}
+		}
+	}
+
+	// Cut power at every byte write of a reset
+	for (uint32_t cut = 0;; cut++)
+	{
+		EEPROM_Counter counter(REGION_SIZE);
+		bool cutHappened = false;
+
+		counter.begin(COUNTER_ADDRESS);
+		uint32_t before = counter.getCount();
+		EEPROM.cutAfter(cut);
+		try
+		{
+			counter.reset(1000 + cut);
+		}
+		catch (HostPowerCut &)
+		{
+			cutHappened = true;
+		}
+		EEPROM.restorePower();
+
+		uint32_t after = reboot();
+		CHECK((after == before) || (after == 1000 + cut));
+		if (!cutHappened)
+		{
+			CHECK(after == 1000 + cut);
+			break;
+		}
+		cuts++;
+	}
+
+	printf("%u power cuts, count never lost or over counted\n", (unsigned)cuts);
+	PASS();
+	return 0;
+}
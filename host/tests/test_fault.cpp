@@ -0,0 +1,59 @@
+/**
+ * @file test_fault.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Fault injection: writes after the cut are dropped, even if the handler returns
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include "EEPROM_Fault.h"
+#include "check.h"
+
+//! @brief Power cuts seen by the handler
+static int cuts = 0;
+
+static void countCut() { cuts++; }
+
+int main()
+{
+	const uint8_t data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+	EEPROM.resize(64);
+
+	// Cut before the fourth byte: the handler returns, and the rest of the object is not written
+	EEPROM_Fault::arm(3, countCut);
+	EEPROM_Fault::put(0, data);
+	CHECK(cuts == 1);
+	CHECK(EEPROM_Fault::hasFired());
+	CHECK(EEPROM_Fault::getBytesWritten() == 3);
+	CHECK(memcmp(EEPROM.data(), data, 3) == 0);
+	for (int i = 3; i < 8; i++)
+	{
+		CHECK(EEPROM.data()[i] == 0xFF);
+	}
+
+	// Still dropped, without calling the handler again, until power is restored
+	EEPROM_Fault::write(20, 0x55);
+	CHECK(EEPROM.data()[20] == 0xFF);
+	CHECK(cuts == 1);
+	EEPROM_Fault::disarm();
+	CHECK(!EEPROM_Fault::hasFired());
+	EEPROM_Fault::write(20, 0x55);
+	CHECK(EEPROM.data()[20] == 0x55);
+
+	// Re-arming also restores power
+	EEPROM_Fault::arm(0, countCut);
+	EEPROM_Fault::write(21, 0x66);
+	CHECK(cuts == 2);
+	CHECK(EEPROM.data()[21] == 0xFF);
+	EEPROM_Fault::arm(10, countCut);
+	EEPROM_Fault::write(21, 0x66);
+	CHECK(EEPROM.data()[21] == 0x66);
+	EEPROM_Fault::disarm();
+
+	PASS();
+	return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file test_fields.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief USER_SETTINGS() table: generated fields[], defaults, range-checked setters, parsing and logging
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include <math.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+#include "UserSettingsClass.h"
+#include "check.h"
+
+/**
+ * @brief Run logUserData() and capture what it logs
+ */
+static std::string captureLog(UserSettingsClass &settings)
+{
+	char path[] = "/tmp/test_fieldsXXXXXX";
+	int fd = mkstemp(path);
+	int saved = dup(2);
+	std::string text;
+	char block[256];
+	ssize_t length;
+
+	CHECK((fd >= 0) && (saved >= 0));
+	fflush(stderr);
+	dup2(fd, 2);
+	Log.setLevel(LOG_LEVEL_INFO);
+	settings.logUserData();
+	Log.setLevel(LOG_LEVEL_NONE);
+	fflush(stderr);
+	dup2(saved, 2);
+	close(saved);
+
+	lseek(fd, 0, SEEK_SET);
+	while ((length = read(fd, block, sizeof(block))) > 0)
+	{
+		text.append(block, length);
+	}
+	close(fd);
+	unlink(path);
+	return text;
+}
+
+int main()
+{
+	EEPROM.resize(4096);
+
+	// One field per table entry, in member order, with the member's offset and size
+	static const char *const names[] = {"timeZone", "dstOffset", "dstEnabled", "hostName", "antennaType"};
+	static const uint8_t types[] = {FIELD_FLOAT, FIELD_FLOAT, FIELD_BOOL, FIELD_STRING, FIELD_ENUM};
+	static const size_t offsets[] = {offsetof(SettingsObject, timeZone), offsetof(SettingsObject, dstOffset),
+									 offsetof(SettingsObject, dstEnabled), offsetof(SettingsObject, hostName),
+									 offsetof(SettingsObject, antennaType)};
+
+	CHECK(UserSettingsClass::fieldCount == 5);
+	for (size_t i = 0; i < UserSettingsClass::fieldCount; i++)
+	{
+		const EEPROM_Field &field = UserSettingsClass::fields[i];
+
+		CHECK(strcmp(field.name, names[i]) == 0);
+		CHECK(field.type == types[i]);
+		CHECK(field.offset == offsets[i]);
+		CHECK(EEPROM_Fields::find(UserSettingsClass::fields, UserSettingsClass::fieldCount, offsets[i]) == &field);
+	}
+	CHECK(UserSettingsClass::fields[3].size == sizeof(((SettingsObject *)0)->hostName));
+	CHECK((UserSettingsClass::fields[0].minValue == -12.0f) && (UserSettingsClass::fields[0].maxValue == 14.0f));
+	CHECK(UserSettingsClass::fields[4].nameCount == 3);
+
+	// Defaults, from the table
+	const SettingsObject &defaults = UserSettingsClass::defaultSettings;
+	CHECK(defaults.timeZone == DEFAULT_USER_TZ);
+	CHECK(defaults.dstOffset == (float)DEFAULT_USER_DSTOFFSET);
+	CHECK(defaults.dstEnabled == DEFAULT_USER_DSTENABLE);
+	CHECK(strcmp(defaults.hostName, DEFAULT_USER_HOSTNAME) == 0);
+	CHECK(defaults.antennaType == DEFAULT_USER_ANTENNA);
+	for (size_t i = 0; i < UserSettingsClass::fieldCount; i++)
+	{
+		CHECK(EEPROM_Fields::validate(UserSettingsClass::fields[i], reinterpret_cast<const uint8_t *>(&defaults) + offsets[i]));
+	}
+
+	// Erased EEPROM: begin() reinitializes to the defaults
+	UserSettingsClass settings;
+	CHECK(!settings.begin(0));
+	CHECK(settings.getTimeZone() == DEFAULT_USER_TZ);
+	CHECK(strcmp(settings.getHostName(), DEFAULT_USER_HOSTNAME) == 0);
+
+	// Range-checked setters: out-of-range values are rejected, unchanged, and not written
+	uint32_t writes = settings.getWriteCount();
+	CHECK(!settings.setTimeZone(14.5f));
+	CHECK(!settings.setTimeZone(-12.5f));
+	CHECK(!settings.setTimeZone(NAN));
+	CHECK(!settings.setDstOffset(2.5f));
+	CHECK(!settings.setAntennaType((WLanSelectAntenna_TypeDef)2));
+	CHECK(settings.getTimeZone() == DEFAULT_USER_TZ);
+	CHECK(settings.getAntennaType() == DEFAULT_USER_ANTENNA);
+	CHECK(settings.getWriteCount() == writes);
+
+	// Unchanged values are accepted without a write
+	CHECK(settings.setTimeZone(DEFAULT_USER_TZ));
+	CHECK(settings.setHostName(DEFAULT_USER_HOSTNAME));
+	CHECK(settings.setDSTEnabled(DEFAULT_USER_DSTENABLE));
+	CHECK(settings.getWriteCount() == writes);
+
+	// Valid values, including the range limits, are written once each
+	CHECK(settings.setTimeZone(14.0f));
+	CHECK(settings.setDstOffset(0.0f));
+	CHECK(settings.setDSTEnabled(!DEFAULT_USER_DSTENABLE));
+	CHECK(settings.setAntennaType(ANT_AUTO));
+	CHECK(settings.setHostName("unit-7"));
+	CHECK(settings.getWriteCount() == writes + 5);
+
+	// A hostname that does not fit is truncated, and reported
+	char longName[40];
+	memset(longName, 'x', sizeof(longName) - 1);
+	longName[sizeof(longName) - 1] = 0;
+	CHECK(!settings.setHostName(longName));
+	CHECK(strlen(settings.getHostName()) == sizeof(((SettingsObject *)0)->hostName) - 1);
+	CHECK(settings.setHostName("unit-7"));
+
+	// The values persist
+	{
+		UserSettingsClass reader;
+
+		CHECK(reader.begin(0));
+		CHECK(reader.getTimeZone() == 14.0f);
+		CHECK(reader.getDstOffset() == 0.0f);
+		CHECK(reader.isDSTEnabled() == !DEFAULT_USER_DSTENABLE);
+		CHECK(reader.getAntennaType() == ANT_AUTO);
+		CHECK(strcmp(reader.getHostName(), "unit-7") == 0);
+	}
+
+	// Parsing from text, validated against the table
+	SettingsObject object = defaults;
+	const EEPROM_Field *fields = UserSettingsClass::fields;
+	CHECK(EEPROM_Fields::parse(fields[0], "-3.5", &object) && (object.timeZone == -3.5f));
+	CHECK(!EEPROM_Fields::parse(fields[0], "15", &object) && (object.timeZone == -3.5f));
+	CHECK(!EEPROM_Fields::parse(fields[0], "1x", &object));
+	CHECK(EEPROM_Fields::parse(fields[2], "No", &object) && !object.dstEnabled);
+	CHECK(EEPROM_Fields::parse(fields[2], "TRUE", &object) && object.dstEnabled);
+	CHECK(!EEPROM_Fields::parse(fields[2], "maybe", &object));
+	CHECK(EEPROM_Fields::parse(fields[3], "abc", &object) && (strcmp(object.hostName, "abc") == 0));
+	CHECK(!EEPROM_Fields::parse(fields[3], longName, &object) && (strcmp(object.hostName, "abc") == 0));
+	CHECK(EEPROM_Fields::parse(fields[4], "external", &object) && (object.antennaType == ANT_EXTERNAL));
+	CHECK(EEPROM_Fields::parse(fields[4], "3", &object) && (object.antennaType == ANT_AUTO));
+	CHECK(!EEPROM_Fields::parse(fields[4], "2", &object) && (object.antennaType == ANT_AUTO));
+	CHECK(!EEPROM_Fields::parse(fields[4], "Sideways", &object));
+	CHECK(strcmp(EEPROM_Fields::enumName(fields[4], &object.antennaType), "Auto") == 0);
+
+	// Logging: label and value of every field, each float in its own format
+	CHECK(settings.setTimeZone(-5.0f));
+	CHECK(settings.setDstOffset(1.0f));
+	std::string text = captureLog(settings);
+	CHECK(text.find("Timezone: -5.00\n") != std::string::npos);
+	CHECK(text.find("DST Offset:  1.0\n") != std::string::npos);
+	CHECK(text.find("DST Enabled: No\n") != std::string::npos);
+	CHECK(text.find("Hostname: unit-7\n") != std::string::npos);
+	CHECK(text.find("Antenna Type: Auto\n") != std::string::npos);
+
+	PASS();
+	return 0;
+}
@@ -0,0 +1,194 @@
+/**
+ * @file test_heap_free.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief UserSettingsClass: no heap allocation in begin(), the setters or logUserData()
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+#include "UserSettingsClass.h"
+#include "check.h"
+
+/**
+ * @details
+ *
+ * The global allocation functions (operator new/delete in every form, and malloc, calloc, realloc and free,
+ * forwarded to the C library's own) are replaced with counting versions, and the count is checked around each
+ * operation in full and sparse mode. Logging is enabled for logUserData(), with stderr sent to /dev/null, so
+ * that it formats every field.
+ */
+
+//! @brief Count allocations only while set
+static bool counting = false;
+
+//! @brief Allocations counted
+static unsigned long allocations = 0;
+
+//! @brief Descriptor of /dev/null, for the log output
+static int nullFile = -1;
+
+extern "C"
+{
+	void *__libc_malloc(size_t size);
+	void *__libc_calloc(size_t count, size_t size);
+	void *__libc_realloc(void *pointer, size_t size);
+	void __libc_free(void *pointer);
+
+	void *malloc(size_t size)
+	{
+		allocations += counting;
+		return __libc_malloc(size);
+	}
+
+	void *calloc(size_t count, size_t size)
+	{
+		allocations += counting;
+		return __libc_calloc(count, size);
+	}
+
+	void *realloc(void *pointer, size_t size)
+	{
+		allocations += counting;
+		return __libc_realloc(pointer, size);
+	}
+
+	void free(void *pointer)
+	{
+		__libc_free(pointer);
+	}
+}
+
+void *operator new(size_t size)
+{
+	void *pointer = malloc(size ? size : 1);
+
+	if (pointer == NULL)
+	{
+		throw std::bad_alloc();
+	}
+	return pointer;
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept { return malloc(size ? size : 1); }
+void *operator new[](size_t size, const std::nothrow_t &) noexcept { return malloc(size ? size : 1); }
+void operator delete(void *pointer) noexcept { free(pointer); }
+void operator delete[](void *pointer) noexcept { free(pointer); }
+void operator delete(void *pointer, size_t) noexcept { free(pointer); }
+void operator delete[](void *pointer, size_t) noexcept { free(pointer); }
+
+/**
+ * @brief Start counting allocations
+ */
+static void startCounting()
+{
+	allocations = 0;
+	counting = true;
+}
+
+/**
+ * @brief Stop counting allocations
+ *
+ * @return unsigned long allocations since startCounting()
+ */
+static unsigned long stopCounting()
+{
+	counting = false;
+	return allocations;
+}
+
+/**
+ * @brief Check every operation of one settings object for allocations
+ *
+ * @param sparse overlay mode
+ */
+static void checkSettings(bool sparse)
+{
+	UserSettingsClass settings(sparse);
+	const char name[] = "heap-free-host";
+
+	EEPROM.resize(4096);
+
+	// First run (defaults written), then a reload of the stored image
+	startCounting();
+	settings.begin(0);
+	CHECK(stopCounting() == 0);
+	startCounting();
+	CHECK(settings.begin(0));
+	CHECK(stopCounting() == 0);
+
+	startCounting();
+	CHECK(settings.setTimeZone(3.5));
+	CHECK(settings.setDstOffset(0.5));
+	CHECK(settings.setDSTEnabled(false));
+	CHECK(settings.setHostName(name));
+	CHECK(settings.setHostName(name, 4));
+	CHECK(!settings.setHostName("a-host-name-longer-than-thirty-one-characters"));
+	CHECK(settings.setAntennaType(ANT_EXTERNAL));
+	CHECK(!settings.setTimeZone(99));
+	CHECK(!settings.setAntennaType((WLanSelectAntenna_TypeDef)42));
+	CHECK(stopCounting() == 0);
+
+	int savedStderr = dup(STDERR_FILENO);
+	dup2(nullFile, STDERR_FILENO);
+	Log.setLevel(LOG_LEVEL_ALL);
+	startCounting();
+	settings.logUserData();
+	unsigned long logAllocations = stopCounting();
+	Log.setLevel(LOG_LEVEL_NONE);
+	dup2(savedStderr, STDERR_FILENO);
+	close(savedStderr);
+	CHECK(logAllocations == 0);
+
+	startCounting();
+	settings.reinitialize();
+	CHECK(stopCounting() == 0);
+}
+
+/**
+ * @brief setHostName() writes EEPROM only when the name changes
+ */
+static void checkHostNameWrites()
+{
+	UserSettingsClass settings;
+
+	EEPROM.resize(4096);
+	settings.begin(0);
+	CHECK(settings.setHostName("first-name"));
+	uint32_t writes = settings.getWriteCount();
+
+	CHECK(settings.setHostName("first-name"));
+	CHECK(settings.setHostName("first-name-and-more", 10));
+	CHECK(settings.getWriteCount() == writes);
+	CHECK(settings.setHostName("second-name"));
+	CHECK(settings.getWriteCount() == writes + 1);
+	CHECK(strcmp(settings.getHostName(), "second-name") == 0);
+}
+
+int main()
+{
+	nullFile = open("/dev/null", O_WRONLY);
+	CHECK(nullFile >= 0);
+
+	// Log once first, so that stdio's own first-use setup is not counted
+	int savedStderr = dup(STDERR_FILENO);
+	dup2(nullFile, STDERR_FILENO);
+	Log.setLevel(LOG_LEVEL_ALL);
+	Log.info("%s %0.2f", "warm-up", 1.5);
+	Log.setLevel(LOG_LEVEL_NONE);
+	dup2(savedStderr, STDERR_FILENO);
+	close(savedStderr);
+
+	checkSettings(false);
+	checkSettings(true);
+	checkHostNameWrites();
+
+	PASS();
+	return 0;
+}
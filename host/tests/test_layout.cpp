@@ -0,0 +1,67 @@
+/**
+ * @file test_layout.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Layout policy: unaligned addresses are rounded up to the record boundary
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include "EEPROM_Class.h"
+#include "check.h"
+
+struct Item
+{
+	uint8_t data[14];
+};
+
+int main()
+{
+	typedef EEPROM_Class<Item, EEPROM_RecordLayout<16> > AlignedClass;
+	Item item = {{1, 2, 3}};
+	Item copy;
+	AlignedClass first;
+	AlignedClass second;
+
+	// Aligned address: image exactly one record, touched by the torn guard, the object and the checksum
+	first.begin(0, item);
+	first.writeObject(item);
+	CHECK(first.getAddress() == 0);
+	CHECK(first.getSize() == 16);
+	CHECK(first.getRecordsWritten() == 3);
+
+	// Unaligned address: image moved to the next record, skipped bytes included in the size
+	second.begin(21, item);
+	second.writeObject(item);
+	CHECK(second.getAddress() == 21);
+	CHECK(second.getSize() == 27);
+	CHECK(EEPROM.data()[34] == 1);
+	CHECK(21 + second.getSize() == 48);
+	CHECK(second.getRecordsWritten() == 3);
+	for (int i = 16; i < 32; i++)
+	{
+		CHECK(EEPROM.data()[i] == 0xFF);
+	}
+
+	AlignedClass reader;
+	CHECK(reader.begin(21, copy));
+	CHECK(memcmp(&copy, &item, sizeof(item)) == 0);
+
+	// Boot loader image: getSize() bytes from getAddress()
+	AlignedClass loaded;
+	memset(&copy, 0, sizeof(copy));
+	loaded.attach(21, copy);
+	CHECK(loaded.loadImage(EEPROM.data() + loaded.getAddress()));
+	CHECK(memcmp(&copy, &item, sizeof(item)) == 0);
+
+	// Default layout is unchanged
+	EEPROM_Class<Item> packed;
+	packed.begin(21, item);
+	CHECK(packed.getAddress() == 21);
+	CHECK(packed.getSize() == 16);
+
+	PASS();
+	return 0;
+}
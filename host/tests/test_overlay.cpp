@@ -0,0 +1,168 @@
+/**
+ * @file test_overlay.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief EEPROM_Class overlay (sparse) mode: round trip, bitmap validation, writes against full mode
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include "EEPROM_Class.h"
+#include "check.h"
+
+/**
+ * @brief 10 chunks of 4 bytes: a 2-byte bitmap with 6 spare bits
+ */
+struct Config
+{
+	uint32_t words[10];
+};
+
+typedef EEPROM_Class<Config> ConfigEEPROM;
+
+static Config makeDefaults()
+{
+	Config config;
+
+	for (size_t i = 0; i < 10; i++)
+	{
+		config.words[i] = 100 + i;
+	}
+	return config;
+}
+
+static const Config defaults = makeDefaults();
+
+//! @brief Address of the overlay image
+static const uint16_t ADDRESS = 32;
+
+/**
+ * @brief Overwrite the stored bitmap and store a matching checksum, so that only the bitmap check can reject it
+ */
+static void forgeBitmap(const uint8_t bitmap[ConfigEEPROM::OVERLAY_BITMAP], size_t imageLength)
+{
+	uint8_t *image = EEPROM.data() + ADDRESS + sizeof(uint16_t);
+	uint16_t checkSum;
+
+	memcpy(image, bitmap, ConfigEEPROM::OVERLAY_BITMAP);
+	checkSum = EEPROM_Checksum::seal(EEPROM_Checksum::calculate(image, imageLength));
+	memcpy(EEPROM.data() + ADDRESS, &checkSum, sizeof(checkSum));
+}
+
+int main()
+{
+	EEPROM.resize(1024);
+	CHECK(ConfigEEPROM::OVERLAY_CHUNKS == 10);
+	CHECK(ConfigEEPROM::OVERLAY_BITMAP == 2);
+
+	// First run: the defaults are stored as an empty bitmap
+	Config config = defaults;
+	ConfigEEPROM sparse;
+
+	sparse.setDefaults(defaults);
+	CHECK(!sparse.begin(ADDRESS, config));
+	sparse.writeObject(config);
+	CHECK(sparse.getBytesWritten() == 2 * sizeof(uint16_t) + ConfigEEPROM::OVERLAY_BITMAP);
+	CHECK(sparse.getSize() == sizeof(uint16_t) + ConfigEEPROM::OVERLAY_BITMAP + sizeof(Config));
+
+	// Round trip: only the chunks that differ are stored, after the bitmap, in order
+	config.words[1] = 0xDEADBEEF;
+	config.words[9] = 7;
+	sparse.writeObject(config);
+	{
+		const uint8_t *image = EEPROM.data() + ADDRESS + sizeof(uint16_t);
+		uint32_t stored[2];
+
+		CHECK((image[0] == 0x02) && (image[1] == 0x02));
+		memcpy(stored, image + ConfigEEPROM::OVERLAY_BITMAP, sizeof(stored));
+		CHECK((stored[0] == 0xDEADBEEF) && (stored[1] == 7));
+	}
+	{
+		Config loaded;
+		ConfigEEPROM reader;
+
+		memset(&loaded, 0, sizeof(loaded));
+		reader.setDefaults(defaults);
+		CHECK(reader.begin(ADDRESS, loaded));
+		CHECK(memcmp(&loaded, &config, sizeof(config)) == 0);
+		CHECK(reader.verifyChecksum(true));
+	}
+
+	// Chunks not stored come from the defaults of the reader
+	{
+		Config newDefaults = defaults;
+		Config loaded;
+		ConfigEEPROM reader;
+
+		newDefaults.words[4] = 44;
+		reader.setDefaults(newDefaults);
+		CHECK(reader.begin(ADDRESS, loaded));
+		CHECK((loaded.words[1] == 0xDEADBEEF) && (loaded.words[4] == 44) && (loaded.words[9] == 7));
+	}
+
+	// Returning a chunk to its default value removes it from the image
+	config.words[1] = defaults.words[1];
+	sparse.writeObject(config);
+	CHECK(EEPROM.data()[ADDRESS + sizeof(uint16_t)] == 0x00);
+	CHECK(EEPROM.data()[ADDRESS + sizeof(uint16_t) + 1] == 0x02);
+
+	// Corrupted bitmap: a spare bit set beyond the last chunk is rejected, even with a matching checksum
+	{
+		const uint8_t bitmap[ConfigEEPROM::OVERLAY_BITMAP] = {0x00, 0x06};
+		Config loaded;
+		ConfigEEPROM reader;
+
+		forgeBitmap(bitmap, ConfigEEPROM::OVERLAY_BITMAP + 4);
+		reader.setDefaults(defaults);
+		CHECK(!reader.begin(ADDRESS, loaded));
+		CHECK(!reader.verifyChecksum(true));
+	}
+
+	// Corrupted bitmap: a flipped chunk bit changes the image length and fails the checksum
+	sparse.writeObject(config);
+	CHECK(sparse.verifyChecksum(true));
+	EEPROM.data()[ADDRESS + sizeof(uint16_t)] ^= 0x01;
+	{
+		Config loaded;
+		ConfigEEPROM reader;
+
+		reader.setDefaults(defaults);
+		CHECK(!reader.begin(ADDRESS, loaded));
+	}
+
+	// Writes per update against full mode: one changed word
+	{
+		EEPROM.resize(1024);
+		Config fullConfig = defaults;
+		Config sparseConfig = defaults;
+		ConfigEEPROM full;
+		ConfigEEPROM overlay;
+		uint64_t writes;
+
+		overlay.setDefaults(defaults);
+		full.begin(0, fullConfig);
+		overlay.begin(256, sparseConfig);
+		full.writeObject(fullConfig);
+		overlay.writeObject(sparseConfig);
+
+		fullConfig.words[3] = 3;
+		writes = EEPROM.getWrites();
+		full.writeObject(fullConfig);
+		uint64_t fullWrites = EEPROM.getWrites() - writes;
+
+		sparseConfig.words[3] = 3;
+		writes = EEPROM.getWrites();
+		overlay.writeObject(sparseConfig);
+		uint64_t sparseWrites = EEPROM.getWrites() - writes;
+
+		// Torn guard and checksum, then the whole object, or the bitmap and the one changed chunk
+		CHECK(fullWrites == 2 * sizeof(uint16_t) + sizeof(Config));
+		CHECK(sparseWrites == 2 * sizeof(uint16_t) + ConfigEEPROM::OVERLAY_BITMAP + ConfigEEPROM::OVERLAY_CHUNK);
+		CHECK(sparseWrites * 4 < fullWrites);
+	}
+
+	PASS();
+	return 0;
+}
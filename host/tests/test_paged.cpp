@@ -0,0 +1,208 @@
+/**
+ * @file test_paged.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief EEPROM_PagedClass: LRU fault-in, get()/put(), verifyChecksum(), power cuts during a write
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include <stddef.h>
+#include <vector>
+#include "EEPROM_PagedClass.h"
+#include "check.h"
+
+/**
+ * @brief Calibration table: 6 pages of 32 bytes, the last one short
+ */
+struct Table
+{
+	float gain[40];
+	uint32_t serial;
+};
+
+typedef EEPROM_PagedClass<Table, 32, 2> PagedTable;
+
+//! @brief EEPROM address of the table
+static const uint16_t ADDRESS = 64;
+
+static Table defaults()
+{
+	Table table;
+
+	for (size_t i = 0; i < 40; i++)
+	{
+		table.gain[i] = i * 0.5f;
+	}
+	table.serial = 1234;
+	return table;
+}
+
+/**
+ * @brief EEPROM reads made by one get()
+ */
+static uint64_t readsFor(PagedTable &paged, size_t index)
+{
+	float gain;
+	uint64_t reads = EEPROM.getReads();
+
+	CHECK(paged.get(offsetof(Table, gain) + index * sizeof(float), gain));
+	CHECK(gain == index * 0.5f);
+	return EEPROM.getReads() - reads;
+}
+
+int main()
+{
+	EEPROM.resize(1024);
+	CHECK(PagedTable::PAGE_COUNT == 6);
+
+	// Erased EEPROM: every page fails its checksum until initialized
+	{
+		PagedTable paged;
+		float gain;
+
+		CHECK(paged.begin(ADDRESS));
+		CHECK(paged.getSize() == sizeof(Table) + 6 * sizeof(uint16_t));
+		CHECK(!paged.verifyChecksum());
+		CHECK(!paged.get(offsetof(Table, gain), gain));
+		paged.initialize(defaults());
+		CHECK(paged.verifyChecksum());
+	}
+
+	// Fault-in: a page is read once, then served from the cache; the least recently used page is evicted
+	{
+		PagedTable paged;
+
+		EEPROM.resetCounters();
+		CHECK(paged.begin(ADDRESS));
+		CHECK(EEPROM.getReads() == 0);
+		CHECK(readsFor(paged, 0) > 0);		// page 0
+		CHECK(readsFor(paged, 1) == 0);		// page 0, cached
+		CHECK(readsFor(paged, 8) > 0);		// page 1
+		CHECK(readsFor(paged, 0) == 0);		// page 0 now most recently used
+		CHECK(readsFor(paged, 16) > 0);		// page 2 evicts page 1
+		CHECK(readsFor(paged, 0) == 0);
+		CHECK(readsFor(paged, 8) > 0);		// page 1 faulted in again, evicting page 2
+		CHECK(readsFor(paged, 16) > 0);
+
+		uint32_t serial;
+		CHECK(paged.get(offsetof(Table, serial), serial) && (serial == 1234));
+	}
+
+	// put(): only the changed bytes and the checksum of their page are written, and the value persists
+	{
+		PagedTable paged;
+		float gain = 7.25f;
+		float same = 7.25f;
+
+		CHECK(paged.begin(ADDRESS));
+		EEPROM.resetCounters();
+		CHECK(paged.put(offsetof(Table, gain) + 3 * sizeof(float), gain));
+		CHECK(EEPROM.getWrites() <= sizeof(float) + 2 * sizeof(uint16_t));
+		EEPROM.resetCounters();
+		CHECK(paged.put(offsetof(Table, gain) + 3 * sizeof(float), same));
+		CHECK(EEPROM.getWrites() == 0);
+
+		// An item across a page boundary (bytes 30..33)
+		uint8_t span[4] = {1, 2, 3, 4};
+		CHECK(paged.write(30, span, sizeof(span)));
+		CHECK(paged.verifyChecksum());
+		CHECK(!paged.put(sizeof(Table) - 2, gain));
+	}
+	{
+		PagedTable paged;
+		float gain;
+		uint8_t span[4];
+
+		CHECK(paged.begin(ADDRESS));
+		CHECK(paged.get(offsetof(Table, gain) + 3 * sizeof(float), gain) && (gain == 7.25f));
+		CHECK(paged.read(30, span, sizeof(span)));
+		CHECK((span[0] == 1) && (span[1] == 2) && (span[2] == 3) && (span[3] == 4));
+	}
+
+	// External corruption: verifyChecksum() reads EEPROM, not the cache; only the damaged page is lost
+	{
+		PagedTable paged;
+		float gain;
+
+		CHECK(paged.begin(ADDRESS));
+		CHECK(paged.get(offsetof(Table, gain) + 9 * sizeof(float), gain));	// page 1 cached
+		EEPROM.data()[ADDRESS + 6 * sizeof(uint16_t) + 40] ^= 0x10;
+		CHECK(!paged.verifyChecksum());
+		CHECK(paged.get(offsetof(Table, gain) + 9 * sizeof(float), gain));	// still cached
+
+		PagedTable fresh;
+		CHECK(fresh.begin(ADDRESS));
+		CHECK(!fresh.get(offsetof(Table, gain) + 9 * sizeof(float), gain));
+		CHECK(fresh.get(offsetof(Table, gain) + 20 * sizeof(float), gain) && (gain == 10.0f));
+		fresh.initialize(defaults());
+		CHECK(fresh.verifyChecksum());
+	}
+
+	// Power cut at every byte of a write across two pages: each page loads old or new bytes, or fails its checksum
+	{
+		const uint8_t before[8] = {0};
+		const uint8_t after[8] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+		std::vector<uint8_t> image;
+		uint32_t total;
+
+		{
+			PagedTable paged;
+			CHECK(paged.begin(ADDRESS));
+			CHECK(paged.write(60, before, sizeof(before)));
+			image.assign(EEPROM.data(), EEPROM.data() + EEPROM.length());
+			EEPROM.resetCounters();
+			CHECK(paged.write(60, after, sizeof(after)));
+			total = EEPROM.getWrites();
+			CHECK(total == sizeof(after) + 4 * sizeof(uint16_t));
+		}
+
+		unsigned failed = 0;
+		for (uint32_t cut = 0; cut < total; cut++)
+		{
+			memcpy(EEPROM.data(), image.data(), image.size());
+			{
+				PagedTable paged;
+				CHECK(paged.begin(ADDRESS));
+				EEPROM.cutAfter(cut);
+				try
+				{
+					paged.write(60, after, sizeof(after));
+				}
+				catch (HostPowerCut &)
+				{
+				}
+				EEPROM.restorePower();
+			}
+
+			PagedTable paged;
+			uint8_t low[4];
+			uint8_t high[4];
+
+			CHECK(paged.begin(ADDRESS));
+			if (paged.read(60, low, sizeof(low)))
+			{
+				CHECK((memcmp(low, before, 4) == 0) || (memcmp(low, after, 4) == 0));
+			}
+			else
+			{
+				failed++;
+			}
+			if (paged.read(64, high, sizeof(high)))
+			{
+				CHECK((memcmp(high, before + 4, 4) == 0) || (memcmp(high, after + 4, 4) == 0));
+			}
+			else
+			{
+				failed++;
+			}
+			CHECK(paged.read(0, low, sizeof(low)));
+		}
+		CHECK(failed > 0);
+	}
+
+	PASS();
+	return 0;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file test_replay.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Trace replay: UserSettingsClass begin path, cached verification spans
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ * Built against the traced library (EEPROM_TRACE defined, see the Makefile).
+ */
+#include <Particle.h>
+#include "EEPROM_Trace.h"
+#include "EEPROM_Replay.h"
+#include "UserSettingsClass.h"
+#include "check.h"
+
+/**
+ * @brief Object traced by this test
+ */
+struct TracedItem
+{
+	uint32_t value;
+	uint8_t data[12];
+};
+
+/**
+ * @brief Append one record to a trace under construction
+ */
+static void addRecord(uint8_t *trace, uint16_t &count, uint8_t op, uint32_t start, uint32_t duration, uint32_t length = 0)
+{
+	EEPROM_TraceEvent event = {start, duration, 0, length, op};
+
+	EEPROM_TraceFormat::encodeRecord(event, &trace[EEPROM_TraceFormat::HEADER_SIZE + count * EEPROM_TraceFormat::RECORD_SIZE]);
+	count++;
+}
+
+int main()
+{
+	// A cached verifyChecksum() records its own span, with no bytes read
+	{
+		EEPROM.resize(4096);
+		TracedItem item = {7, {0}};
+		EEPROM_Class<TracedItem> traced;
+		uint8_t trace[EEPROM_TraceFormat::HEADER_SIZE + 64 * EEPROM_TraceFormat::RECORD_SIZE];
+
+		traced.begin(0, item);
+		traced.writeObject(item);
+		EEPROM_Trace::clear();
+		CHECK(traced.verifyChecksum());
+		size_t length = EEPROM_Trace::exportBinary(trace, sizeof(trace));
+		CHECK(EEPROM_TraceFormat::decodeHeader(trace, length) == 1);
+
+		EEPROM_TraceEvent event;
+		EEPROM_TraceFormat::decodeRecord(&trace[EEPROM_TraceFormat::HEADER_SIZE], event);
+		CHECK(event.op == TRACE_VERIFY_CACHED);
+		CHECK(event.length == 0);
+		CHECK(strcmp(EEPROM_TraceFormat::opName(event.op), "verify_cached") == 0);
+	}
+
+	// Records keep lengths of 64 KiB and more, and every operation code
+	{
+		uint8_t record[EEPROM_TraceFormat::RECORD_SIZE];
+		EEPROM_TraceEvent event = {1, 2, 3, 70000, TRACE_VERIFY_CACHED};
+		EEPROM_TraceEvent decoded;
+
+		EEPROM_TraceFormat::encodeRecord(event, record);
+		EEPROM_TraceFormat::decodeRecord(record, decoded);
+		CHECK((decoded.start == 1) && (decoded.duration == 2) && (decoded.address == 3));
+		CHECK(decoded.length == 70000);
+		CHECK(decoded.op == TRACE_VERIFY_CACHED);
+	}
+
+	// A field trace: boot, cached verify, write, cached verify, read
+	uint8_t trace[EEPROM_TraceFormat::HEADER_SIZE + 5 * EEPROM_TraceFormat::RECORD_SIZE];
+	uint16_t count = 0;
+	addRecord(trace, count, TRACE_BEGIN, 0, 500);
+	addRecord(trace, count, TRACE_VERIFY_CACHED, 600, 1);
+	addRecord(trace, count, TRACE_WRITE, 700, 300);
+	addRecord(trace, count, TRACE_VERIFY_CACHED, 1100, 1);
+	addRecord(trace, count, TRACE_READ, 1200, 50);
+	EEPROM_TraceFormat::encodeHeader(trace, count);
+
+	// UserSettingsClass: begin() on erased EEPROM takes its own path and writes the defaults
+	{
+		EEPROM.resize(4096);
+		UserSettingsClass settings;
+		SettingsObject scratch;
+		EEPROM_Replay<SettingsObject> replay;
+
+		memset(&scratch, 0, sizeof(scratch));
+		CHECK(replay.load(trace, sizeof(trace)));
+		replay.run(settings, scratch);
+
+		CHECK(replay.getStats(TRACE_BEGIN).count == 1);
+		CHECK(replay.getStats(TRACE_BEGIN).bytesWritten > 0);
+		CHECK(replay.getStats(TRACE_VERIFY_CACHED).count == 2);
+		CHECK(replay.getStats(TRACE_VERIFY_CACHED).bytesRead == 0);
+		CHECK(replay.getStats(TRACE_WRITE).count == 1);
+		CHECK(replay.getStats(TRACE_WRITE).bytesWritten > 0);
+		CHECK(replay.getStats(TRACE_READ).count == 1);
+
+		// Reads and writes went to the settings' own working copy, which stays attached
+		CHECK(settings.getObject() != &scratch);
+		CHECK(strcmp(settings.getHostName(), DEFAULT_USER_HOSTNAME) == 0);
+		CHECK(settings.verifyChecksum(true));
+		for (size_t i = 0; i < sizeof(scratch); i++)
+		{
+			CHECK(reinterpret_cast<uint8_t *>(&scratch)[i] == 0);
+		}
+	}
+
+	// Plain EEPROM_Class: begin() only reads, and the given working copy is used
+	{
+		EEPROM.resize(4096);
+		EEPROM_Class<SettingsObject> plain;
+		SettingsObject object = UserSettingsClass::defaultSettings;
+		EEPROM_Replay<SettingsObject> replay;
+
+		CHECK(replay.load(trace, sizeof(trace)));
+		replay.run(plain, object);
+		CHECK(replay.getStats(TRACE_BEGIN).bytesWritten == 0);
+		CHECK(replay.getStats(TRACE_WRITE).bytesWritten > 0);
+		CHECK(plain.getObject() == &object);
+	}
+
+	// A put and a checksum outside any write (e.g. EEPROM_BootLoader::sealDefaults()) are skipped, not replayed as writes
+	{
+		uint8_t sealed[EEPROM_TraceFormat::HEADER_SIZE + 4 * EEPROM_TraceFormat::RECORD_SIZE];
+		uint16_t sealedCount = 0;
+		EEPROM.resize(4096);
+		EEPROM_Class<SettingsObject> plain;
+		SettingsObject object = UserSettingsClass::defaultSettings;
+		EEPROM_Replay<SettingsObject> replay;
+
+		addRecord(sealed, sealedCount, TRACE_BEGIN, 0, 100, sizeof(object));
+		addRecord(sealed, sealedCount, TRACE_PUT, 200, 100, sizeof(object));
+		addRecord(sealed, sealedCount, TRACE_CHECKSUM, 400, 100, sizeof(object));
+		addRecord(sealed, sealedCount, TRACE_READ, 600, 100, sizeof(object));
+		EEPROM_TraceFormat::encodeHeader(sealed, sealedCount);
+
+		CHECK(replay.load(sealed, sizeof(sealed)));
+		replay.run(plain, object);
+		CHECK(replay.getStats(TRACE_PUT).count == 0);
+		CHECK(replay.getStats(TRACE_PUT).skipped == 1);
+		CHECK(replay.getStats(TRACE_CHECKSUM).skipped == 1);
+		CHECK(replay.getStats(TRACE_WRITE).count == 0);
+		CHECK(replay.getStats(TRACE_READ).count == 1);
+		CHECK(plain.getBytesWritten() == 0);
+	}
+
+	PASS();
+	return 0;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file test_ring_log.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Ring log recovery: torn newest record and damaged slot 0, in wrapped and unwrapped logs
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include "EEPROM_RingLog.h"
+#include "check.h"
+
+//! @brief Log capacity (records)
+static const size_t CAPACITY = 16;
+
+typedef EEPROM_RingLog<uint32_t, 1> Log16;
+
+/**
+ * @brief Write records 0..written-1, the last one cut by power loss part way through its slot if torn
+ */
+static void fill(uint32_t written, bool torn)
+{
+	Log16 writer(CAPACITY);
+
+	EEPROM.resize(writer.getSize());
+	writer.begin(0);
+	for (uint32_t i = 0; i < written; i++)
+	{
+		if (torn && (i == written - 1))
+		{
+			EEPROM.cutAfter(3);
+		}
+		try
+		{
+			writer.append(i * 10);
+		}
+		catch (HostPowerCut &)
+		{
+		}
+		EEPROM.restorePower();
+	}
+}
+
+/**
+ * @brief Damage the slot of one record
+ */
+static void damage(uint32_t sequence)
+{
+	size_t slotSize = Log16(CAPACITY).getSize() / CAPACITY;
+
+	EEPROM.data()[(sequence % CAPACITY) * slotSize + 5] ^= 0x01;
+}
+
+/**
+ * @brief Boot a log and check what it finds and reads back
+ *
+ * @param count expected record count
+ * @param first expected oldest readable sequence
+ * @param readable expected number of records read
+ * @param next expected next sequence
+ */
+static void check(size_t count, uint32_t first, size_t readable, uint32_t next)
+{
+	Log16 reader(CAPACITY);
+	uint32_t record = 0;
+	uint32_t sequence;
+	uint32_t expected = first;
+	size_t read = 0;
+
+	reader.begin(0);
+	CHECK(reader.getCount() == count);
+	CHECK(reader.getNextSequence() == next);
+	while (reader.readNext(record, &sequence))
+	{
+		if (read == 0)
+		{
+			CHECK(sequence == first);
+		}
+		CHECK(sequence >= expected);
+		CHECK(record == sequence * 10);
+		expected = sequence + 1;
+		read++;
+	}
+	CHECK(read == readable);
+	CHECK(expected == next);
+
+	// Appending after recovery continues the sequence, and the new record reads back last
+	reader.append(12345);
+	Log16 again(CAPACITY);
+	again.begin(0);
+	CHECK(again.getNextSequence() == next + 1);
+	while (again.readNext(record, &sequence))
+	{
+		expected = sequence;
+	}
+	CHECK((expected == next) && (record == 12345));
+}
+
+int main()
+{
+	// Intact logs
+	fill(0, false);
+	check(0, 0, 0, 0);
+	fill(5, false);
+	check(5, 0, 5, 5);
+	fill(38, false);
+	check(16, 22, 16, 38);
+
+	// Newest write torn: only that record is lost
+	fill(38, true);
+	check(15, 22, 15, 37);
+	fill(6, true);
+	check(5, 0, 5, 5);
+	fill(33, true);
+	check(15, 17, 15, 32);
+
+	// Slot 0 damaged: full scan
+	fill(5, false);
+	damage(0);
+	check(4, 1, 4, 5);
+	fill(38, false);
+	damage(32);
+	check(16, 22, 15, 38);
+	fill(1, false);
+	damage(0);
+	check(0, 0, 0, 0);
+
+	// A damaged slot in the middle is skipped, the records after it are still read
+	fill(38, false);
+	damage(27);
+	check(16, 22, 15, 38);
+
+	PASS();
+	return 0;
+}
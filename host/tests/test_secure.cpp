@@ -0,0 +1,172 @@
+/**
+ * @file test_secure.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief EEPROM_SecureClass: fresh nonce on every write, tampered and moved blocks rejected, power cuts
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include <vector>
+#include "EEPROM_SecureClass.h"
+#include "check.h"
+
+/**
+ * @brief Secret object spanning two blocks
+ */
+struct Credentials
+{
+	char userName[16];
+	char password[16];
+};
+
+typedef EEPROM_SecureClass<Credentials> SecureCredentials;
+
+int main()
+{
+	static const uint8_t key[EEPROM_Cipher::KEY_SIZE] = {1, 2, 3, 4};
+	Credentials credentials;
+	Credentials loaded;
+
+	EEPROM.resize(4096);
+	memset(&credentials, 0, sizeof(credentials));
+	strcpy(credentials.userName, "admin");
+	strcpy(credentials.password, "secret");
+
+	// Constant-time compare
+	CHECK(EEPROM_Cipher::equal("abcdefgh", "abcdefgh", 8));
+	CHECK(!EEPROM_Cipher::equal("abcdefgh", "abcdefgX", 8));
+	CHECK(!EEPROM_Cipher::equal("Xbcdefgh", "abcdefgh", 8));
+
+	// Round trip
+	{
+		SecureCredentials secure;
+		CHECK(secure.begin(0, key));
+		secure.initialize(credentials);
+	}
+	{
+		SecureCredentials secure;
+		CHECK(secure.begin(0, key));
+		CHECK(secure.verify());
+		CHECK(secure.readObject(loaded));
+		CHECK(memcmp(&loaded, &credentials, sizeof(loaded)) == 0);
+	}
+
+	// The same plaintext written again gets a new nonce and ciphertext, even after the stored nonce is erased
+	uint8_t before[SecureCredentials::SLOT_SIZE];
+	memcpy(before, EEPROM.data(), sizeof(before));
+	memset(EEPROM.data(), 0, EEPROM_Cipher::NONCE_SIZE);
+	{
+		SecureCredentials secure;
+		CHECK(secure.begin(0, key));
+		CHECK(!secure.verify());
+		secure.initialize(credentials);
+		CHECK(secure.verify());
+	}
+	CHECK(memcmp(before, EEPROM.data(), EEPROM_Cipher::NONCE_SIZE) != 0);
+	CHECK(memcmp(&before[EEPROM_Cipher::NONCE_SIZE], EEPROM.data() + EEPROM_Cipher::NONCE_SIZE, 16) != 0);
+
+	// One item rewrites only its block
+	{
+		SecureCredentials secure;
+		CHECK(secure.begin(0, key));
+		CHECK(secure.put(offsetof(Credentials, password), "changed"));
+		CHECK(secure.getBlocksRead() == 1);
+		CHECK(secure.getBlocksWritten() == 1);
+	}
+
+	// Altered tag, ciphertext or nonce: rejected
+	for (size_t index : {SecureCredentials::SLOT_SIZE - 1, EEPROM_Cipher::NONCE_SIZE + 3, (size_t)5})
+	{
+		SecureCredentials secure;
+
+		EEPROM.data()[index] ^= 0x01;
+		CHECK(secure.begin(0, key));
+		CHECK(!secure.get(offsetof(Credentials, userName), loaded.userName));
+		EEPROM.data()[index] ^= 0x01;
+		CHECK(secure.get(offsetof(Credentials, userName), loaded.userName));
+		CHECK(strcmp(loaded.userName, "admin") == 0);
+	}
+
+	// Blocks swapped: rejected
+	{
+		SecureCredentials secure;
+		uint8_t slot[SecureCredentials::SLOT_SIZE];
+
+		memcpy(slot, EEPROM.data(), sizeof(slot));
+		memcpy(EEPROM.data(), EEPROM.data() + sizeof(slot), sizeof(slot));
+		memcpy(EEPROM.data() + sizeof(slot), slot, sizeof(slot));
+		CHECK(secure.begin(0, key));
+		CHECK(!secure.verify());
+		CHECK(!secure.readObject(loaded));
+	}
+
+	// Power cut at every byte of a one-block write: the block holds the old or new value, or fails
+	// authentication; the other block stays readable and initialize() recovers the object
+	{
+		std::vector<uint8_t> image;
+		uint32_t total;
+
+		{
+			SecureCredentials secure;
+			CHECK(secure.begin(0, key));
+			secure.initialize(credentials);
+			image.assign(EEPROM.data(), EEPROM.data() + EEPROM.length());
+			EEPROM.resetCounters();
+			CHECK(secure.put(offsetof(Credentials, password), "changed"));
+			total = EEPROM.getWrites();
+			CHECK(total == SecureCredentials::SLOT_SIZE);
+		}
+
+		unsigned failed = 0;
+		for (uint32_t cut = 0; cut < total; cut++)
+		{
+			memcpy(EEPROM.data(), image.data(), image.size());
+			{
+				SecureCredentials secure;
+				CHECK(secure.begin(0, key));
+				EEPROM.cutAfter(cut);
+				try
+				{
+					secure.put(offsetof(Credentials, password), "changed");
+				}
+				catch (HostPowerCut &)
+				{
+				}
+				EEPROM.restorePower();
+			}
+
+			SecureCredentials secure;
+			char password[16];
+
+			CHECK(secure.begin(0, key));
+			CHECK(secure.get(offsetof(Credentials, userName), loaded.userName));
+			CHECK(strcmp(loaded.userName, "admin") == 0);
+			if (secure.get(offsetof(Credentials, password), password))
+			{
+				CHECK((strcmp(password, "secret") == 0) || (strcmp(password, "changed") == 0));
+				continue;
+			}
+			failed++;
+			CHECK(!secure.verify());
+			CHECK(!secure.readObject(loaded));
+			CHECK(!secure.put(offsetof(Credentials, password), "changed"));
+
+			// Recovery: carry over the intact items and rewrite the object
+			Credentials recovered;
+			memset(&recovered, 0, sizeof(recovered));
+			strcpy(recovered.userName, loaded.userName);
+			strcpy(recovered.password, "reset");
+			secure.initialize(recovered);
+			CHECK(secure.verify());
+			CHECK(secure.readObject(loaded));
+			CHECK((strcmp(loaded.userName, "admin") == 0) && (strcmp(loaded.password, "reset") == 0));
+		}
+		CHECK(failed > 0);
+	}
+
+	PASS();
+	return 0;
+}
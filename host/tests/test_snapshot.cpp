@@ -0,0 +1,105 @@
+/**
+ * @file test_snapshot.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Snapshots: round trip, type tag, field validation and the wear budget on import
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include "EEPROM_Snapshot.h"
+#include "UserSettingsClass.h"
+#include "check.h"
+
+/**
+ * @brief Another object of the same size as SettingsObject, to check the type tag
+ */
+struct OtherObject
+{
+	uint8_t bytes[sizeof(SettingsObject)];
+};
+
+EEPROM_SNAPSHOT_TAG(OtherObject, 0x4F54);
+
+//! @brief Simulated clock (milliseconds)
+static uint32_t simulatedMillis = 0;
+
+static uint32_t simulatedClock() { return simulatedMillis; }
+
+int main()
+{
+	EEPROM.resize(4096);
+
+	UserSettingsClass source;
+	source.begin(0);
+	CHECK(source.setTimeZone(-5));
+	CHECK(source.setHostName("snapshot-source"));
+
+	uint8_t buffer[UserSettingsClass::SNAPSHOT_SIZE];
+	CHECK(source.exportSnapshot(buffer, sizeof(buffer) - 1) == 0);
+	CHECK(source.exportSnapshot(buffer, sizeof(buffer)) == sizeof(buffer));
+
+	// Round trip, with one write
+	UserSettingsClass target;
+	target.begin(1024);
+	uint32_t writes = target.getWriteCount();
+	CHECK(target.importSnapshot(buffer, sizeof(buffer)));
+	CHECK(target.getWriteCount() == writes + 1);
+	CHECK(target.getTimeZone() == -5);
+	CHECK(strcmp(target.getHostName(), "snapshot-source") == 0);
+	CHECK(target.verifyChecksum());
+
+	// Corrupted snapshot: rejected, settings unchanged
+	uint8_t damaged[sizeof(buffer)];
+	memcpy(damaged, buffer, sizeof(buffer));
+	damaged[sizeof(damaged) - 1] ^= 0x40;
+	CHECK(target.setTimeZone(2));
+	writes = target.getWriteCount();
+	CHECK(!target.importSnapshot(damaged, sizeof(damaged)));
+	CHECK(target.getTimeZone() == 2);
+	CHECK(target.getWriteCount() == writes);
+
+	// Snapshot of another type of the same size, with a valid checksum: rejected by the tag
+	OtherObject other;
+	memset(&other, 0, sizeof(other));
+	uint8_t foreign[EEPROM_Snapshot::HEADER_SIZE + sizeof(OtherObject)];
+	CHECK(EEPROM_Snapshot::typeTag<OtherObject>() != EEPROM_Snapshot::typeTag<SettingsObject>());
+
+	// Tags are explicit constants: the settings tag is unchanged from earlier versions, which hashed the name
+	CHECK(EEPROM_Snapshot::typeTag<SettingsObject>() == EEPROM_Snapshot::nameTag("SettingsObject", 14));
+	CHECK(EEPROM_Snapshot::encode(&other, sizeof(other), EEPROM_Snapshot::typeTag<OtherObject>(), foreign,
+								  sizeof(foreign)) == sizeof(foreign));
+	CHECK(!target.importSnapshot(foreign, sizeof(foreign)));
+	CHECK(target.getTimeZone() == 2);
+
+	// Valid snapshot of a setting out of range: rejected by the field table
+	SettingsObject invalid = UserSettingsClass::defaultSettings;
+	invalid.timeZone = 99;
+	CHECK(EEPROM_Snapshot::encode(&invalid, sizeof(invalid), EEPROM_Snapshot::typeTag<SettingsObject>(), damaged,
+								  sizeof(damaged)) == sizeof(damaged));
+	CHECK(!target.importSnapshot(damaged, sizeof(damaged)));
+	CHECK(target.getTimeZone() == 2);
+	CHECK(target.getWriteCount() == writes);
+
+	// Wear budget exhausted: refused rather than held, settings unchanged
+	simulatedMillis = 1000;
+	target.getWearBudget().setClock(simulatedClock);
+	target.setWearBudget(1);
+	CHECK(target.setTimeZone(3));
+	CHECK(target.getRemainingWrites() == 0);
+	writes = target.getWriteCount();
+	CHECK(!target.importSnapshot(buffer, sizeof(buffer)));
+	CHECK(target.getTimeZone() == 3);
+	CHECK(target.getWriteCount() == writes);
+
+	// Allowed again once the budget refills
+	simulatedMillis += 3600000;
+	CHECK(target.importSnapshot(buffer, sizeof(buffer)));
+	CHECK(target.getTimeZone() == -5);
+	CHECK(target.getWriteCount() == writes + 1);
+
+	PASS();
+	return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file test_snapshot_encode.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief snapshot_encode tool: a fleet CSV encoded to snapshots that import into UserSettingsClass
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include <stdlib.h>
+#include <string>
+#include "UserSettingsClass.h"
+#include "check.h"
+
+/**
+ * @brief Read a snapshot file
+ *
+ * @return size_t length read, 0 if missing
+ */
+static size_t readFile(const std::string &path, uint8_t *buffer, size_t length)
+{
+	FILE *file = fopen(path.c_str(), "rb");
+	size_t read;
+
+	if (file == NULL)
+	{
+		return 0;
+	}
+	read = fread(buffer, 1, length, file);
+	fclose(file);
+	return read;
+}
+
+int main()
+{
+	char directory[] = "/tmp/snapshot_encodeXXXXXX";
+	CHECK(mkdtemp(directory) != NULL);
+	std::string dir = directory;
+
+	FILE *csv = fopen((dir + "/fleet.csv").c_str(), "w");
+	CHECK(csv != NULL);
+	fprintf(csv, "device,timeZone,dstEnabled,hostName,antennaType\n");
+	fprintf(csv, "unit-1,-5,no,unit-one,External\n");
+	fprintf(csv, "unit-2,,,, \n");
+	fprintf(csv, "unit-3,99,yes,bad,Internal\n");
+	fprintf(csv, "unit-4,1.5,maybe,ok,Sideways\n");
+	fclose(csv);
+
+	// Two rows rejected: exit status 1, the valid rows still written
+	std::string command = "build/snapshot_encode -o " + dir + " " + dir + "/fleet.csv > /dev/null 2>&1";
+	int status = system(command.c_str());
+	CHECK(WIFEXITED(status) && (WEXITSTATUS(status) == 1));
+
+	uint8_t snapshot[UserSettingsClass::SNAPSHOT_SIZE + 1];
+	CHECK(readFile(dir + "/unit-3.snap", snapshot, sizeof(snapshot)) == 0);
+	CHECK(readFile(dir + "/unit-4.snap", snapshot, sizeof(snapshot)) == 0);
+
+	EEPROM.resize(4096);
+	UserSettingsClass settings;
+	settings.begin(0);
+
+	size_t length = readFile(dir + "/unit-1.snap", snapshot, sizeof(snapshot));
+	CHECK(length == UserSettingsClass::SNAPSHOT_SIZE);
+	CHECK(settings.importSnapshot(snapshot, length));
+	CHECK(settings.getTimeZone() == -5);
+	CHECK(!settings.isDSTEnabled());
+	CHECK(strcmp(settings.getHostName(), "unit-one") == 0);
+	CHECK(settings.getAntennaType() == ANT_EXTERNAL);
+	CHECK(settings.getDstOffset() == DEFAULT_USER_DSTOFFSET);
+
+	// Empty cells keep the defaults
+	length = readFile(dir + "/unit-2.snap", snapshot, sizeof(snapshot));
+	CHECK(settings.importSnapshot(snapshot, length));
+	CHECK(memcmp(settings.getObject(), &UserSettingsClass::defaultSettings, sizeof(SettingsObject)) == 0);
+
+	command = "rm -rf " + dir;
+	CHECK(system(command.c_str()) == 0);
+
+	PASS();
+	return 0;
+}
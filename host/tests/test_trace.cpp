@@ -0,0 +1,395 @@
+/**
+ * @file test_trace.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Trace hooks: Chrome JSON from EEPROM_Trace::dump() and the trace_dump tool, concurrent recording
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ * Built against the traced library (EEPROM_TRACE defined, see the Makefile).
+ */
+#include <Particle.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "EEPROM_Class.h"
+#include "check.h"
+
+/**
+ * @brief Print into a string
+ */
+class StringPrint : public Print
+{
+public:
+	size_t write(uint8_t c)
+	{
+		text += (char)c;
+		return 1;
+	}
+
+	std::string text;
+};
+
+/**
+ * @brief Minimal JSON parser: objects, arrays, strings without escapes, non-negative integers
+ */
+class JsonParser
+{
+public:
+	/**
+	 * @brief Parsed value
+	 */
+	struct Value
+	{
+		char type;	// '{', '[', '"' or '0'
+		std::string text;
+		unsigned long number;
+		std::vector<std::pair<std::string, Value> > members;
+		std::vector<Value> items;
+
+		const Value *member(const char *name) const
+		{
+			for (size_t i = 0; i < members.size(); i++)
+			{
+				if (members[i].first == name)
+				{
+					return &members[i].second;
+				}
+			}
+			return NULL;
+		}
+	};
+
+	/**
+	 * @brief Parse a complete document, with optional trailing white space
+	 */
+	static bool parse(const std::string &text, Value &value)
+	{
+		const char *p = text.c_str();
+
+		if (!_value(p, value))
+		{
+			return false;
+		}
+		_space(p);
+		return *p == 0;
+	}
+
+private:
+	static void _space(const char *&p)
+	{
+		while ((*p == ' ') || (*p == '\n') || (*p == '\r') || (*p == '\t'))
+		{
+			p++;
+		}
+	}
+
+	static bool _string(const char *&p, std::string &text)
+	{
+		if (*p++ != '"')
+		{
+			return false;
+		}
+		while ((*p != '"') && (*p != 0) && (*p != '\\'))
+		{
+			text += *p++;
+		}
+		return *p++ == '"';
+	}
+
+	static bool _value(const char *&p, Value &value)
+	{
+		_space(p);
+		value.type = *p;
+		if (*p == '"')
+		{
+			return _string(p, value.text);
+		}
+		if ((*p >= '0') && (*p <= '9'))
+		{
+			value.type = '0';
+			value.number = strtoul(p, const_cast<char **>(&p), 10);
+			return true;
+		}
+		if ((*p != '{') && (*p != '['))
+		{
+			return false;
+		}
+
+		char close = (*p++ == '{') ? '}' : ']';
+		_space(p);
+		if (*p == close)
+		{
+			p++;
+			return true;
+		}
+		for (;;)
+		{
+			Value item;
+
+			if (close == '}')
+			{
+				std::string name;
+
+				_space(p);
+				if (!_string(p, name))
+				{
+					return false;
+				}
+				_space(p);
+				if ((*p++ != ':') || !_value(p, item))
+				{
+					return false;
+				}
+				value.members.push_back(std::make_pair(name, item));
+			}
+			else
+			{
+				if (!_value(p, item))
+				{
+					return false;
+				}
+				value.items.push_back(item);
+			}
+			_space(p);
+			if (*p == close)
+			{
+				p++;
+				return true;
+			}
+			if (*p++ != ',')
+			{
+				return false;
+			}
+		}
+	}
+};
+
+/**
+ * @brief Parse Chrome trace_event JSON and check the shape of every event
+ *
+ * @param text JSON text
+ * @param events receives the spans
+ * @return true valid, every event a complete ("X") eeprom span with a known operation name
+ */
+static bool parseTrace(const std::string &text, std::vector<EEPROM_TraceEvent> &events)
+{
+	JsonParser::Value document;
+
+	if (!JsonParser::parse(text, document) || (document.type != '{'))
+	{
+		return false;
+	}
+
+	const JsonParser::Value *list = document.member("traceEvents");
+	if ((list == NULL) || (list->type != '['))
+	{
+		return false;
+	}
+	for (size_t i = 0; i < list->items.size(); i++)
+	{
+		const JsonParser::Value &item = list->items[i];
+		const JsonParser::Value *name = item.member("name");
+		const JsonParser::Value *cat = item.member("cat");
+		const JsonParser::Value *ph = item.member("ph");
+		const JsonParser::Value *ts = item.member("ts");
+		const JsonParser::Value *dur = item.member("dur");
+		const JsonParser::Value *args = item.member("args");
+		EEPROM_TraceEvent event = {0, 0, 0, 0, 0xFF};
+
+		if ((name == NULL) || (cat == NULL) || (ph == NULL) || (ts == NULL) || (dur == NULL) || (args == NULL) ||
+			(item.member("pid") == NULL) || (item.member("tid") == NULL) ||
+			(cat->text != "eeprom") || (ph->text != "X") || (ts->type != '0') || (dur->type != '0'))
+		{
+			return false;
+		}
+
+		const JsonParser::Value *address = args->member("address");
+		const JsonParser::Value *length = args->member("length");
+		if ((address == NULL) || (length == NULL) || (address->type != '0') || (length->type != '0'))
+		{
+			return false;
+		}
+		for (uint8_t op = 0; op <= TRACE_VERIFY_CACHED; op++)
+		{
+			if (name->text == EEPROM_TraceFormat::opName(op))
+			{
+				event.op = op;
+			}
+		}
+		if (event.op == 0xFF)
+		{
+			return false;
+		}
+		event.start = ts->number;
+		event.duration = dur->number;
+		event.address = address->number;
+		event.length = length->number;
+		events.push_back(event);
+	}
+	return true;
+}
+
+/**
+ * @brief Run a command and capture its standard output
+ *
+ * @return int exit status, -1 if it could not run
+ */
+static int runCommand(const std::string &command, std::string &output)
+{
+	FILE *pipe = popen(command.c_str(), "r");
+	char block[1024];
+	size_t read;
+
+	if (pipe == NULL)
+	{
+		return -1;
+	}
+	while ((read = fread(block, 1, sizeof(block), pipe)) > 0)
+	{
+		output.append(block, read);
+	}
+
+	int status = pclose(pipe);
+	return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+static bool sameEvent(const EEPROM_TraceEvent &a, const EEPROM_TraceEvent &b)
+{
+	return (a.start == b.start) && (a.duration == b.duration) && (a.address == b.address) && (a.length == b.length) && (a.op == b.op);
+}
+
+struct Item
+{
+	uint32_t value;
+	uint8_t data[20];
+};
+
+int main()
+{
+	EEPROM.resize(4096);
+
+	// Spans of EEPROM_Class operations, dumped as Chrome JSON
+	Item item = {1, {0}};
+	EEPROM_Class<Item> eeprom;
+	std::vector<EEPROM_TraceEvent> dumped;
+	StringPrint json;
+
+	eeprom.begin(16, item);
+	EEPROM_Trace::clear();
+	item.value = 2;
+	eeprom.writeObject(item);
+	eeprom.readObject(item);
+	EEPROM_Trace::dump(json);
+	CHECK(parseTrace(json.text, dumped));
+
+	bool seen[TRACE_VERIFY_CACHED + 1] = {false};
+	for (size_t i = 0; i < dumped.size(); i++)
+	{
+		seen[dumped[i].op] = true;
+		if (dumped[i].op != TRACE_VERIFY_CACHED)
+		{
+			CHECK(dumped[i].length == sizeof(Item));
+		}
+		if (i > 0)
+		{
+			CHECK((int32_t)(dumped[i].start + dumped[i].duration - dumped[i - 1].start - dumped[i - 1].duration) >= 0);
+		}
+	}
+	CHECK(seen[TRACE_WRITE] && seen[TRACE_PUT] && seen[TRACE_CHECKSUM] && seen[TRACE_READ]);
+	CHECK(!seen[TRACE_BEGIN]);
+
+	// The binary export, decoded by the host dumper, gives the same spans
+	uint8_t trace[EEPROM_TraceFormat::HEADER_SIZE + EEPROM_TRACE_SIZE * EEPROM_TraceFormat::RECORD_SIZE];
+	size_t length = EEPROM_Trace::exportBinary(trace, sizeof(trace));
+	char path[] = "/tmp/trace_dumpXXXXXX";
+	int fd = mkstemp(path);
+	CHECK(fd >= 0);
+	CHECK(write(fd, trace, length) == (ssize_t)length);
+	close(fd);
+
+	std::string output;
+	std::vector<EEPROM_TraceEvent> decoded;
+	CHECK(runCommand(std::string("build/trace_dump ") + path, output) == 0);
+	CHECK(parseTrace(output, decoded));
+	CHECK(decoded.size() == dumped.size());
+	for (size_t i = 0; i < decoded.size(); i++)
+	{
+		CHECK(sameEvent(decoded[i], dumped[i]));
+	}
+
+	// A damaged trace is rejected
+	trace[EEPROM_TraceFormat::HEADER_SIZE] ^= 1;
+	fd = open(path, O_WRONLY | O_TRUNC);
+	CHECK(fd >= 0);
+	CHECK(write(fd, trace, length) == (ssize_t)length);
+	close(fd);
+	output.clear();
+	CHECK(runCommand(std::string("build/trace_dump ") + path + " 2> /dev/null", output) == 1);
+	unlink(path);
+
+	// Empty buffer: valid JSON without events
+	std::vector<EEPROM_TraceEvent> none;
+	StringPrint empty;
+	EEPROM_Trace::clear();
+	EEPROM_Trace::dump(empty);
+	CHECK(parseTrace(empty.text, none) && none.empty());
+
+	// Concurrent writers: every span read back is whole, never a mix of two spans
+	const unsigned WRITERS = 4;
+	std::atomic<bool> done(false);
+	std::vector<std::thread> writers;
+	unsigned checked = 0;
+
+	for (unsigned t = 0; t < WRITERS; t++)
+	{
+		writers.push_back(std::thread([t, &done]() {
+			for (uint32_t n = 0; !done.load(); n++)
+			{
+				EEPROM_Trace::record(t, t, n * 3, n, n ^ 0xA5A5A5A5);
+				std::this_thread::sleep_for(std::chrono::microseconds(1));
+			}
+		}));
+	}
+	for (unsigned round = 0; (round < 1000000) && (checked < 20000); round++)
+	{
+		std::vector<EEPROM_TraceEvent> spans;
+		StringPrint text;
+
+		length = EEPROM_Trace::exportBinary(trace, sizeof(trace));
+		CHECK(EEPROM_TraceFormat::decodeHeader(trace, length) >= 0);
+		for (size_t i = 0; (i + 1) * EEPROM_TraceFormat::RECORD_SIZE + EEPROM_TraceFormat::HEADER_SIZE <= length; i++)
+		{
+			EEPROM_TraceEvent event;
+
+			EEPROM_TraceFormat::decodeRecord(&trace[EEPROM_TraceFormat::HEADER_SIZE + i * EEPROM_TraceFormat::RECORD_SIZE], event);
+			spans.push_back(event);
+		}
+		EEPROM_Trace::dump(text);
+		CHECK(parseTrace(text.text, spans));
+		for (size_t i = 0; i < spans.size(); i++)
+		{
+			CHECK(spans[i].address < WRITERS);
+			CHECK(spans[i].op == spans[i].address);
+			CHECK(spans[i].duration == (spans[i].start ^ 0xA5A5A5A5));
+			CHECK(spans[i].length == spans[i].start * 3);
+		}
+		checked += spans.size();
+	}
+	done = true;
+	for (size_t t = 0; t < writers.size(); t++)
+	{
+		writers[t].join();
+	}
+	CHECK(checked >= 20000);
+
+	PASS();
+	return 0;
+}
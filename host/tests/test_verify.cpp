@@ -0,0 +1,115 @@
+/**
+ * @file test_verify.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief verifyChecksum() generation cache and incremental scrub()
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include "EEPROM_Class.h"
+#include "check.h"
+
+struct Item
+{
+	uint32_t value;
+	uint8_t data[60];
+};
+
+typedef EEPROM_Class<Item> ItemEEPROM;
+
+/**
+ * @brief Scrub in steps until a full pass completes
+ *
+ * @return ItemEEPROM::ScrubStatus result of the pass
+ */
+static ItemEEPROM::ScrubStatus scrubPass(ItemEEPROM &eeprom, size_t maxBytes, unsigned &calls)
+{
+	ItemEEPROM::ScrubStatus status;
+
+	calls = 0;
+	do
+	{
+		status = eeprom.scrub(maxBytes);
+		calls++;
+	} while ((status == ItemEEPROM::SCRUB_IN_PROGRESS) && (calls < 1000));
+	return status;
+}
+
+int main()
+{
+	EEPROM.resize(4096);
+
+	Item item = {1, {0}};
+	ItemEEPROM eeprom;
+	uint64_t reads;
+	uint32_t bytesRead;
+
+	CHECK(!eeprom.begin(0, item));
+	eeprom.writeObject(item);
+
+	// Hit after a write: the image was checksummed from the media as it was written
+	reads = EEPROM.getReads();
+	bytesRead = eeprom.getBytesRead();
+	CHECK(eeprom.verifyChecksum());
+	CHECK(EEPROM.getReads() == reads);
+	CHECK(eeprom.getBytesRead() == bytesRead);
+
+	// Miss: an object attached without reading verifies from EEPROM once, then hits
+	{
+		Item other;
+		ItemEEPROM attached;
+
+		attached.attach(0, other);
+		reads = EEPROM.getReads();
+		CHECK(attached.verifyChecksum());
+		CHECK(EEPROM.getReads() - reads >= sizeof(Item));
+		reads = EEPROM.getReads();
+		CHECK(attached.verifyChecksum());
+		CHECK(EEPROM.getReads() == reads);
+	}
+
+	// External corruption: invisible to the cache, caught by deep = true, which also updates the cache
+	EEPROM.data()[sizeof(uint16_t) + 10] ^= 0x01;
+	CHECK(eeprom.verifyChecksum());
+	CHECK(!eeprom.verifyChecksum(true));
+	reads = EEPROM.getReads();
+	CHECK(!eeprom.verifyChecksum());
+	CHECK(EEPROM.getReads() == reads);
+
+	// A write replaces the image: valid again, from the cache
+	item.value = 2;
+	eeprom.writeObject(item);
+	CHECK(eeprom.verifyChecksum());
+	CHECK(eeprom.verifyChecksum(true));
+
+	// Scrub: a full pass in steps of at most maxBytes
+	unsigned calls;
+	reads = EEPROM.getReads();
+	CHECK(eeprom.scrub(16) == ItemEEPROM::SCRUB_IN_PROGRESS);
+	CHECK(EEPROM.getReads() - reads == 16);
+	CHECK(scrubPass(eeprom, 16, calls) == ItemEEPROM::SCRUB_VALID);
+	CHECK(calls == sizeof(Item) / 16 - 1);
+
+	// A write during a pass restarts it, so the pass does not mix old and new bytes
+	CHECK(eeprom.scrub(16) == ItemEEPROM::SCRUB_IN_PROGRESS);
+	CHECK(eeprom.scrub(16) == ItemEEPROM::SCRUB_IN_PROGRESS);
+	item.value = 0x12345678;
+	memset(item.data, 0x5A, sizeof(item.data));
+	eeprom.writeObject(item);
+	CHECK(scrubPass(eeprom, 16, calls) == ItemEEPROM::SCRUB_VALID);
+	CHECK(calls == sizeof(Item) / 16);
+
+	// Scrub finds external corruption and updates the verifyChecksum() cache
+	EEPROM.data()[sizeof(uint16_t) + sizeof(Item) - 1] ^= 0x80;
+	CHECK(eeprom.verifyChecksum());
+	CHECK(scrubPass(eeprom, 16, calls) == ItemEEPROM::SCRUB_INVALID);
+	reads = EEPROM.getReads();
+	CHECK(!eeprom.verifyChecksum());
+	CHECK(EEPROM.getReads() == reads);
+
+	PASS();
+	return 0;
+}
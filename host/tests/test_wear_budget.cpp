@@ -0,0 +1,199 @@
+/**
+ * @file test_wear_budget.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Wear budget: rate and lifetime limits against a simulated clock
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include "EEPROM_WearBudget.h"
+#include "EEPROM_Class.h"
+#include "check.h"
+
+//! @brief Simulated clock (milliseconds)
+static uint32_t simulatedMillis = 0;
+
+static uint32_t simulatedClock() { return simulatedMillis; }
+
+/**
+ * @brief Take writes from the budget until it refuses
+ *
+ * @param budget wear budget
+ * @param limit maximum number to take
+ * @return uint32_t writes allowed
+ */
+static uint32_t drain(EEPROM_WearBudget &budget, uint32_t limit = 10000000)
+{
+	uint32_t allowed = 0;
+
+	while ((allowed < limit) && budget.consume())
+	{
+		allowed++;
+	}
+	return allowed;
+}
+
+struct Item
+{
+	uint32_t value;
+};
+
+int main()
+{
+	// Unlimited by default
+	{
+		EEPROM_WearBudget budget;
+		budget.setClock(simulatedClock);
+		CHECK(drain(budget, 1000) == 1000);
+		CHECK(budget.getRemaining() == EEPROM_WearBudget::UNLIMITED);
+		CHECK(budget.getRemainingLifetime() == EEPROM_WearBudget::UNLIMITED);
+	}
+
+	// Burst of one hour's worth, then one write per refill interval
+	{
+		EEPROM_WearBudget budget;
+		simulatedMillis = 1000;
+		budget.setClock(simulatedClock);
+		budget.configure(10);
+		CHECK(budget.getRemaining() == 10);
+		CHECK(drain(budget) == 10);
+		simulatedMillis += 359999;
+		CHECK(!budget.consume());
+		simulatedMillis += 1;
+		CHECK(budget.consume());
+		CHECK(!budget.consume());
+
+		// Refill is capped at one hour's worth
+		simulatedMillis += 10 * 3600000UL;
+		CHECK(budget.getRemaining() == 10);
+		CHECK(drain(budget) == 10);
+	}
+
+	// Refill across the 32-bit millis() wrap
+	{
+		EEPROM_WearBudget budget;
+		simulatedMillis = 0xFFFFFFFFUL - 100000;
+		budget.setClock(simulatedClock);
+		budget.configure(3600);
+		CHECK(drain(budget) == 3600);
+		simulatedMillis += 200000;
+		CHECK(budget.getRemaining() == 200);
+	}
+
+	// Rates above one write per millisecond: no divide by zero, refill clamped to 1/ms
+	{
+		const uint32_t rates[] = {3600000UL, 3600001UL, 100000000UL, 0xFFFFFFFFUL};
+
+		for (size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++)
+		{
+			EEPROM_WearBudget budget;
+			simulatedMillis = 5000;
+			budget.setClock(simulatedClock);
+			budget.configure(rates[i]);
+			CHECK(budget.getRemaining() == rates[i]);
+			CHECK(drain(budget, 1000) == 1000);
+			simulatedMillis += 7;
+			CHECK(budget.getRemaining() == rates[i] - 1000 + 7);
+			simulatedMillis += 0x7FFFFFFF;
+			CHECK(budget.getRemaining() == rates[i]);
+		}
+	}
+
+	// Lifetime limit, with a restored count
+	{
+		EEPROM_WearBudget budget;
+		budget.setClock(simulatedClock);
+		budget.configure(0, 100);
+		budget.setLifetimeWrites(90);
+		CHECK(budget.getLifetimeWrites() == 90);
+		CHECK(budget.getRemainingLifetime() == 10);
+		CHECK(drain(budget) == 10);
+		CHECK(budget.getLifetimeWrites() == 100);
+		CHECK(budget.getRemainingLifetime() == 0);
+		simulatedMillis += 3600000UL;
+		CHECK(!budget.consume());
+		CHECK(!budget.consume(true));
+	}
+
+	// The lifetime count survives a reset when persisted and restored
+	{
+		EEPROM_WearBudget before;
+		EEPROM_WearBudget after;
+
+		before.setClock(simulatedClock);
+		before.configure(5, 20);
+		CHECK(drain(before) == 5);
+		CHECK(before.consume(true));
+		CHECK(before.getLifetimeWrites() == 6);
+
+		after.setClock(simulatedClock);
+		after.configure(5, 20);
+		after.setLifetimeWrites(before.getLifetimeWrites());
+		CHECK(after.getRemainingLifetime() == 14);
+	}
+
+	// EEPROM_Class: writes beyond the budget are held and coalesced by process()
+	{
+		EEPROM_Class<Item> image;
+		Item item = {0};
+		Item stored;
+
+		simulatedMillis = 0;
+		image.getWearBudget().setClock(simulatedClock);
+		image.setWearBudget(2);
+		image.begin(0, item);
+		for (uint32_t value = 1; value <= 5; value++)
+		{
+			item.value = value;
+			image.writeObject(item);
+		}
+		CHECK(image.getWriteCount() == 2);
+		CHECK(image.isPending());
+		CHECK(!image.process());
+		simulatedMillis += 1800000UL;
+		CHECK(image.process());
+		CHECK(!image.isPending());
+		CHECK(image.getWriteCount() == 3);
+		EEPROM.get(2, stored);
+		CHECK(stored.value == 5);
+		CHECK(image.getLifetimeWrites() == 3);
+
+		// flush() writes a held update without waiting for the rate limit, and charges it
+		item.value = 6;
+		image.writeObject(item);
+		item.value = 7;
+		image.writeObject(item);
+		CHECK(image.isPending());
+		CHECK(image.flush());
+		CHECK(!image.isPending());
+		CHECK(!image.flush());
+		CHECK(image.getLifetimeWrites() == 4);
+		EEPROM.get(2, stored);
+		CHECK(stored.value == 7);
+	}
+
+	// flush() still respects the lifetime limit
+	{
+		EEPROM_Class<Item> image;
+		Item item = {0};
+
+		simulatedMillis = 0;
+		image.getWearBudget().setClock(simulatedClock);
+		image.setWearBudget(1, 1);
+		image.begin(0, item);
+		item.value = 1;
+		image.writeObject(item);
+		item.value = 2;
+		image.writeObject(item);
+		CHECK(image.isPending());
+		CHECK(!image.flush());
+		CHECK(image.isPending());
+		CHECK(image.getRemainingLifetimeWrites() == 0);
+	}
+
+	PASS();
+	return 0;
+}
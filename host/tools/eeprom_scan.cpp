@@ -0,0 +1,970 @@
+/**
+ * @file eeprom_scan.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Fleet EEPROM dump scanner: verifies and decodes registered object layouts in a directory of dumps
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#include "EEPROM_Checksum.h"
+#include "EEPROM_Class.h"
+#include "UserSettingsClass.h"
+
+/**
+ * @details
+ *
+ * Every regular file in the directory is an EEPROM dump pulled from one device. Each is memory-mapped and
+ * checked against the layouts given with -t (default: settings@0):
+ * 	- settings@ADDR          UserSettingsClass image (SettingsObject), every field validated with its fields[] entry
+ * 	- sparse-settings@ADDR   UserSettingsClass(true) image (overlay mode), decoded by EEPROM_Class::loadImage()
+ * 	- raw:SIZE@ADDR          any EEPROM_Class object of SIZE bytes with the default layout, checksum only
+ *
+ * Other objects are supported by adding an entry to layoutTypes[].
+ *
+ * Checksums of full images and the count of erased (0xFF) bytes per dump are computed with an AVX2 or SSE2
+ * kernel, chosen at run time (-k to override), and self-checked against EEPROM_Checksum on startup. Files are
+ * spread over a pool of worker threads, each with its own deque of file batches: a worker takes its newest
+ * batch, and an idle worker steals the oldest batch of another.
+ *
+ * The report gives, per layout, the number of images valid, with invalid fields (per field), with a bad
+ * checksum, erased (never written) or truncated (dump too short), and the scan throughput. The exit status is
+ * 1 if any image is not valid.
+ *
+ * With -G count, a synthetic fleet is written to the directory first, using the library on the simulated
+ * EEPROM: mostly valid devices, with some erased, corrupted and out-of-range images.
+ *
+ * Usage: eeprom_scan [-t layout]... [-j threads] [-k avx2|sse2|swar] [-r repeats] [-v] [-G count [-s dump size]] DIR
+ */
+
+/******************************************************************************
+ * Kernels
+ ******************************************************************************/
+
+/**
+ * @brief Checksum and erased-byte kernels
+ */
+struct ScanKernel
+{
+	const char *name;
+	/** EEPROM_Checksum::calculate() equivalent */
+	uint16_t (*checksum)(const uint8_t *data, size_t length);
+	/** Number of 0xFF bytes */
+	size_t (*countErased)(const uint8_t *data, size_t length);
+	/** CPU support */
+	bool (*supported)();
+};
+
+static uint16_t checksumSWAR(const uint8_t *data, size_t length)
+{
+	return EEPROM_Checksum::calculate(data, length);
+}
+
+static size_t countErasedSWAR(const uint8_t *data, size_t length)
+{
+	size_t erased = 0;
+
+	for (size_t i = 0; i < length; i++)
+	{
+		erased += (data[i] == 0xFF);
+	}
+	return erased;
+}
+
+static bool alwaysSupported() { return true; }
+
+#if defined(__x86_64__) || defined(__i386__)
+
+__attribute__((target("sse2"))) static uint16_t checksumSSE2(const uint8_t *data, size_t length)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i sums = zero;
+	size_t i = 0;
+	uint64_t lanes[2];
+
+	// Sum of absolute differences against zero adds each group of 8 bytes into a 64-bit lane
+	for (; i + 16 <= length; i += 16)
+	{
+		sums = _mm_add_epi64(sums, _mm_sad_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)), zero));
+	}
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), sums);
+	return EEPROM_Checksum::calculate(data + i, length - i, (uint16_t)(lanes[0] + lanes[1]));
+}
+
+__attribute__((target("sse2"))) static size_t countErasedSSE2(const uint8_t *data, size_t length)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i erased = _mm_set1_epi8((char)0xFF);
+	__m128i totals = zero;
+	size_t i = 0;
+	uint64_t lanes[2];
+
+	while (i + 16 <= length)
+	{
+		// Count matches per byte lane (each match is -1, so subtract), folding before a lane can pass 255
+		__m128i counts = zero;
+		size_t end = min(length & ~(size_t)15, i + 255 * 16);
+
+		for (; i < end; i += 16)
+		{
+			counts = _mm_sub_epi8(counts, _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)), erased));
+		}
+		totals = _mm_add_epi64(totals, _mm_sad_epu8(counts, zero));
+	}
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), totals);
+	return lanes[0] + lanes[1] + countErasedSWAR(data + i, length - i);
+}
+
+__attribute__((target("avx2"))) static uint16_t checksumAVX2(const uint8_t *data, size_t length)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i sums[2] = {zero, zero};
+	size_t i = 0;
+	uint64_t lanes[4];
+
+	// Two accumulators, to overlap the loads with the adds
+	for (; i + 64 <= length; i += 64)
+	{
+		sums[0] = _mm256_add_epi64(sums[0], _mm256_sad_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)), zero));
+		sums[1] = _mm256_add_epi64(sums[1], _mm256_sad_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + 32)), zero));
+	}
+	for (; i + 32 <= length; i += 32)
+	{
+		sums[0] = _mm256_add_epi64(sums[0], _mm256_sad_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)), zero));
+	}
+	_mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), _mm256_add_epi64(sums[0], sums[1]));
+	return EEPROM_Checksum::calculate(data + i, length - i, (uint16_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]));
+}
+
+__attribute__((target("avx2"))) static size_t countErasedAVX2(const uint8_t *data, size_t length)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i erased = _mm256_set1_epi8((char)0xFF);
+	__m256i totals = zero;
+	size_t i = 0;
+	uint64_t lanes[4];
+
+	while (i + 32 <= length)
+	{
+		__m256i counts = zero;
+		size_t end = min(length & ~(size_t)31, i + 255 * 32);
+
+		for (; i < end; i += 32)
+		{
+			counts = _mm256_sub_epi8(counts, _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)), erased));
+		}
+		totals = _mm256_add_epi64(totals, _mm256_sad_epu8(counts, zero));
+	}
+	_mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), totals);
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3] + countErasedSWAR(data + i, length - i);
+}
+
+static bool avx2Supported() { return __builtin_cpu_supports("avx2"); }
+
+static bool sse2Supported() { return __builtin_cpu_supports("sse2"); }
+
+#endif
+
+//! @brief Kernels, fastest first
+static const ScanKernel kernels[] = {
+#if defined(__x86_64__) || defined(__i386__)
+	{"avx2", checksumAVX2, countErasedAVX2, avx2Supported},
+	{"sse2", checksumSSE2, countErasedSSE2, sse2Supported},
+#endif
+	{"swar", checksumSWAR, countErasedSWAR, alwaysSupported},
+};
+
+/**
+ * @brief Check a kernel against EEPROM_Checksum and a byte loop, over unaligned buffers of every length to 600
+ *
+ * @param kernel kernel
+ * @return true Kernel agrees
+ */
+static bool checkKernel(const ScanKernel &kernel)
+{
+	std::mt19937 generator(1);
+	std::vector<uint8_t> buffer(640);
+
+	for (size_t length = 0; length <= 600; length++)
+	{
+		size_t offset = length % 32;
+
+		for (size_t i = 0; i < buffer.size(); i++)
+		{
+			// Mostly erased bytes in some buffers, to exercise the erased count
+			buffer[i] = ((length & 1) && (generator() & 1)) ? 0xFF : (uint8_t)generator();
+		}
+		if ((kernel.checksum(&buffer[offset], length) != EEPROM_Checksum::calculate(&buffer[offset], length)) ||
+			(kernel.countErased(&buffer[offset], length) != countErasedSWAR(&buffer[offset], length)))
+		{
+			return false;
+		}
+	}
+
+	// Long erased run, past the per-lane fold interval
+	std::vector<uint8_t> erased(256 * 64 + 7, 0xFF);
+	return (kernel.countErased(erased.data(), erased.size()) == erased.size()) &&
+		   (kernel.checksum(erased.data(), erased.size()) == EEPROM_Checksum::calculate(erased.data(), erased.size()));
+}
+
+/******************************************************************************
+ * Layouts
+ ******************************************************************************/
+
+/**
+ * @brief Result of checking one layout in one dump
+ */
+enum ImageStatus
+{
+	IMAGE_VALID,
+	IMAGE_FIELDS_INVALID,
+	IMAGE_CHECKSUM_INVALID,
+	IMAGE_ERASED,
+	IMAGE_TRUNCATED,
+	IMAGE_STATUS_COUNT
+};
+
+static const char *statusNames[IMAGE_STATUS_COUNT] = {"valid", "bad fields", "bad checksum", "erased", "truncated"};
+
+//! @brief Maximum fields per layout (one bit each in the invalid-field mask)
+static const size_t MAX_FIELDS = 32;
+
+/**
+ * @brief Check every field of a decoded object
+ *
+ * @return uint32_t bit i set if fields[i] is invalid
+ */
+static uint32_t validateFields(const EEPROM_Field *fields, size_t count, const void *object)
+{
+	uint32_t invalid = 0;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		if (!EEPROM_Fields::validate(fields[i], static_cast<const uint8_t *>(object) + fields[i].offset))
+		{
+			invalid |= 1UL << i;
+		}
+	}
+	return invalid;
+}
+
+/**
+ * @brief Decoder for one layout. Each worker thread has its own instances.
+ */
+class LayoutDecoder
+{
+public:
+	virtual ~LayoutDecoder() {}
+
+	/**
+	 * @brief Bytes of the dump the image may occupy from its address
+	 */
+	virtual size_t getSize() = 0;
+
+	/**
+	 * @brief Verify and decode an image that is not erased
+	 *
+	 * @param image getSize() bytes of the dump at the layout address
+	 * @param kernel checksum kernel
+	 * @param invalidFields receives the invalid-field mask
+	 * @return ImageStatus IMAGE_VALID, IMAGE_FIELDS_INVALID or IMAGE_CHECKSUM_INVALID
+	 */
+	virtual ImageStatus decode(const uint8_t *image, const ScanKernel &kernel, uint32_t &invalidFields) = 0;
+};
+
+/**
+ * @brief EEPROM_Class image with the default layout: checksum, then the object
+ */
+class FullLayout : public LayoutDecoder
+{
+public:
+	FullLayout(size_t size, const EEPROM_Field *fields, size_t fieldCount)
+		: _size(size), _fields(fields), _fieldCount(fieldCount), _object(size) {}
+
+	size_t getSize() { return sizeof(uint16_t) + _size; }
+
+	ImageStatus decode(const uint8_t *image, const ScanKernel &kernel, uint32_t &invalidFields)
+	{
+		uint16_t stored;
+
+		memcpy(&stored, image, sizeof(stored));
+		if (EEPROM_Checksum::seal(kernel.checksum(image + sizeof(stored), _size)) != stored)
+		{
+			return IMAGE_CHECKSUM_INVALID;
+		}
+		// Copy out, so that fields are read aligned
+		memcpy(_object.data(), image + sizeof(stored), _size);
+		invalidFields = validateFields(_fields, _fieldCount, _object.data());
+		return (invalidFields != 0) ? IMAGE_FIELDS_INVALID : IMAGE_VALID;
+	}
+
+private:
+	size_t _size;
+	const EEPROM_Field *_fields;
+	size_t _fieldCount;
+	std::vector<uint8_t> _object;
+};
+
+/**
+ * @brief EEPROM_Class image in overlay mode, decoded by the library's own loadImage()
+ *
+ * @tparam OBJ object type
+ */
+template <class OBJ>
+class OverlayLayout : public LayoutDecoder
+{
+public:
+	OverlayLayout(const OBJ &defaults, const EEPROM_Field *fields, size_t fieldCount)
+		: _fields(fields), _fieldCount(fieldCount)
+	{
+		_image.setDefaults(defaults);
+		_image.attach(0, _object);
+	}
+
+	size_t getSize() { return _image.getSize(); }
+
+	ImageStatus decode(const uint8_t *image, const ScanKernel &kernel, uint32_t &invalidFields)
+	{
+		(void)kernel;
+		if (!_image.loadImage(image))
+		{
+			return IMAGE_CHECKSUM_INVALID;
+		}
+		invalidFields = validateFields(_fields, _fieldCount, &_object);
+		return (invalidFields != 0) ? IMAGE_FIELDS_INVALID : IMAGE_VALID;
+	}
+
+private:
+	EEPROM_Class<OBJ> _image;
+	OBJ _object;
+	const EEPROM_Field *_fields;
+	size_t _fieldCount;
+};
+
+/**
+ * @brief Registered layout type
+ */
+struct LayoutType
+{
+	/** Name used with -t */
+	const char *name;
+	/** Object size, 0 if given with -t name:SIZE */
+	size_t size;
+	/** Field table, NULL for checksum only */
+	const EEPROM_Field *fields;
+	/** Number of fields */
+	size_t fieldCount;
+	/** Create a decoder for an object of the given size */
+	LayoutDecoder *(*create)(const LayoutType &type, size_t size);
+};
+
+static LayoutDecoder *createFull(const LayoutType &type, size_t size)
+{
+	return new FullLayout(size, type.fields, type.fieldCount);
+}
+
+static LayoutDecoder *createSparseSettings(const LayoutType &type, size_t size)
+{
+	(void)size;
+	return new OverlayLayout<SettingsObject>(UserSettingsClass::defaultSettings, type.fields, type.fieldCount);
+}
+
+//! @brief Layouts known to the scanner
+static const LayoutType layoutTypes[] = {
+	{"settings", sizeof(SettingsObject), UserSettingsClass::fields, UserSettingsClass::fieldCount, createFull},
+	{"sparse-settings", sizeof(SettingsObject), UserSettingsClass::fields, UserSettingsClass::fieldCount, createSparseSettings},
+	{"raw", 0, NULL, 0, createFull},
+};
+
+/**
+ * @brief A layout to check, as given with -t
+ */
+struct LayoutSpec
+{
+	const LayoutType *type;
+	size_t size;
+	uint16_t address;
+	std::string label;
+};
+
+/**
+ * @brief Parse a layout: name[:size][@address]
+ *
+ * @return true Layout valid
+ */
+static bool parseLayout(const char *text, LayoutSpec &spec)
+{
+	std::string name(text);
+	unsigned long address = 0;
+	unsigned long size = 0;
+	size_t at = name.find('@');
+
+	if (at != std::string::npos)
+	{
+		address = strtoul(name.c_str() + at + 1, NULL, 0);
+		name.erase(at);
+	}
+	size_t colon = name.find(':');
+	if (colon != std::string::npos)
+	{
+		size = strtoul(name.c_str() + colon + 1, NULL, 0);
+		name.erase(colon);
+	}
+
+	for (size_t i = 0; i < sizeof(layoutTypes) / sizeof(layoutTypes[0]); i++)
+	{
+		if (name == layoutTypes[i].name)
+		{
+			spec.type = &layoutTypes[i];
+			spec.size = (layoutTypes[i].size != 0) ? layoutTypes[i].size : size;
+			spec.address = address;
+			spec.label = name + ((layoutTypes[i].size == 0) ? ":" + std::to_string(size) : "") + "@" + std::to_string(address);
+			return (spec.size != 0) && (address <= 0xFFFF) && (spec.type->fieldCount <= MAX_FIELDS);
+		}
+	}
+	return false;
+}
+
+/******************************************************************************
+ * Scanning
+ ******************************************************************************/
+
+/**
+ * @brief Counts for one layout
+ */
+struct LayoutStats
+{
+	uint64_t status[IMAGE_STATUS_COUNT];
+	uint64_t invalidFields[MAX_FIELDS];
+};
+
+/**
+ * @brief Counts kept by one worker, added together for the report
+ */
+struct ScanStats
+{
+	uint64_t files = 0;
+	uint64_t bytes = 0;
+	uint64_t erasedBytes = 0;
+	uint64_t unreadable = 0;
+	uint64_t healthy = 0;
+	uint64_t steals = 0;
+	std::vector<LayoutStats> layouts;
+	std::vector<std::string> problems;
+
+	void add(const ScanStats &other)
+	{
+		files += other.files;
+		bytes += other.bytes;
+		erasedBytes += other.erasedBytes;
+		unreadable += other.unreadable;
+		healthy += other.healthy;
+		steals += other.steals;
+		for (size_t l = 0; l < layouts.size(); l++)
+		{
+			for (size_t s = 0; s < IMAGE_STATUS_COUNT; s++)
+			{
+				layouts[l].status[s] += other.layouts[l].status[s];
+			}
+			for (size_t f = 0; f < MAX_FIELDS; f++)
+			{
+				layouts[l].invalidFields[f] += other.layouts[l].invalidFields[f];
+			}
+		}
+		problems.insert(problems.end(), other.problems.begin(), other.problems.end());
+	}
+};
+
+/**
+ * @brief Per-worker deque of file batches. The owner takes from the back, thieves from the front.
+ */
+class WorkQueue
+{
+public:
+	void push(size_t batch)
+	{
+		std::lock_guard<std::mutex> guard(_lock);
+		_batches.push_back(batch);
+	}
+
+	bool pop(size_t &batch)
+	{
+		std::lock_guard<std::mutex> guard(_lock);
+		if (_batches.empty())
+		{
+			return false;
+		}
+		batch = _batches.back();
+		_batches.pop_back();
+		return true;
+	}
+
+	bool steal(size_t &batch)
+	{
+		std::lock_guard<std::mutex> guard(_lock);
+		if (_batches.empty())
+		{
+			return false;
+		}
+		batch = _batches.front();
+		_batches.pop_front();
+		return true;
+	}
+
+private:
+	std::mutex _lock;
+	std::deque<size_t> _batches;
+};
+
+//! @brief Files per batch
+static const size_t BATCH_FILES = 16;
+
+/**
+ * @brief Scan settings shared by the workers
+ */
+struct ScanContext
+{
+	const std::vector<std::string> *files;
+	const std::vector<LayoutSpec> *layouts;
+	const ScanKernel *kernel;
+	bool verbose;
+};
+
+/**
+ * @brief Check one mapped dump against every layout
+ */
+static void scanDump(const ScanContext &context, const std::string &path, const uint8_t *data, size_t length,
+					 std::vector<LayoutDecoder *> &decoders, ScanStats &stats)
+{
+	bool healthy = true;
+
+	stats.files++;
+	stats.bytes += length;
+	stats.erasedBytes += context.kernel->countErased(data, length);
+
+	for (size_t l = 0; l < decoders.size(); l++)
+	{
+		const LayoutSpec &spec = (*context.layouts)[l];
+		size_t size = decoders[l]->getSize();
+		uint32_t invalidFields = 0;
+		ImageStatus status;
+
+		if (spec.address + size > length)
+		{
+			status = IMAGE_TRUNCATED;
+		}
+		else if (context.kernel->countErased(data + spec.address, size) == size)
+		{
+			status = IMAGE_ERASED;
+		}
+		else
+		{
+			status = decoders[l]->decode(data + spec.address, *context.kernel, invalidFields);
+		}
+
+		stats.layouts[l].status[status]++;
+		for (size_t f = 0; f < spec.type->fieldCount; f++)
+		{
+			if (invalidFields & (1UL << f))
+			{
+				stats.layouts[l].invalidFields[f]++;
+			}
+		}
+		if (status != IMAGE_VALID)
+		{
+			healthy = false;
+			if (context.verbose)
+			{
+				stats.problems.push_back(path + ": " + spec.label + " " + statusNames[status]);
+			}
+		}
+	}
+	if (healthy)
+	{
+		stats.healthy++;
+	}
+}
+
+/**
+ * @brief Map and scan one file
+ */
+static void scanFile(const ScanContext &context, const std::string &path, std::vector<LayoutDecoder *> &decoders, ScanStats &stats)
+{
+	int fd = open(path.c_str(), O_RDONLY);
+	struct stat info;
+
+	if ((fd < 0) || (fstat(fd, &info) != 0) || (info.st_size == 0))
+	{
+		stats.unreadable++;
+		stats.problems.push_back(path + ": " + ((fd < 0) ? strerror(errno) : "empty"));
+		if (fd >= 0)
+		{
+			close(fd);
+		}
+		return;
+	}
+
+	void *map = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+	{
+		stats.unreadable++;
+		stats.problems.push_back(path + ": " + strerror(errno));
+		return;
+	}
+	scanDump(context, path, static_cast<const uint8_t *>(map), info.st_size, decoders, stats);
+	munmap(map, info.st_size);
+}
+
+/**
+ * @brief Worker thread: scan own batches, then steal from the others until no work is left
+ */
+static void worker(const ScanContext &context, std::vector<WorkQueue> &queues, size_t self, ScanStats &stats)
+{
+	std::vector<LayoutDecoder *> decoders;
+	size_t batch;
+
+	for (size_t l = 0; l < context.layouts->size(); l++)
+	{
+		const LayoutSpec &spec = (*context.layouts)[l];
+		decoders.push_back(spec.type->create(*spec.type, spec.size));
+	}
+	stats.layouts.assign(context.layouts->size(), LayoutStats());
+
+	for (;;)
+	{
+		bool found = queues[self].pop(batch);
+
+		// No batches are added once scanning starts, so all deques empty means done
+		for (size_t i = 1; !found && (i < queues.size()); i++)
+		{
+			found = queues[(self + i) % queues.size()].steal(batch);
+			stats.steals += found;
+		}
+		if (!found)
+		{
+			break;
+		}
+
+		size_t end = min(context.files->size(), (batch + 1) * BATCH_FILES);
+		for (size_t f = batch * BATCH_FILES; f < end; f++)
+		{
+			scanFile(context, (*context.files)[f], decoders, stats);
+		}
+	}
+
+	for (size_t l = 0; l < decoders.size(); l++)
+	{
+		delete decoders[l];
+	}
+}
+
+/**
+ * @brief Scan every file with a pool of threads
+ *
+ * @return ScanStats combined counts
+ */
+static ScanStats scan(const ScanContext &context, size_t threads)
+{
+	size_t batches = (context.files->size() + BATCH_FILES - 1) / BATCH_FILES;
+	std::vector<WorkQueue> queues(threads);
+	std::vector<ScanStats> stats(threads);
+	std::vector<std::thread> pool;
+	ScanStats total;
+
+	// Contiguous ranges per worker; uneven files are balanced by stealing
+	for (size_t b = 0; b < batches; b++)
+	{
+		queues[b * threads / max(batches, (size_t)1)].push(b);
+	}
+	for (size_t t = 0; t < threads; t++)
+	{
+		pool.push_back(std::thread(worker, std::cref(context), std::ref(queues), t, std::ref(stats[t])));
+	}
+
+	total.layouts.assign(context.layouts->size(), LayoutStats());
+	for (size_t t = 0; t < threads; t++)
+	{
+		pool[t].join();
+		total.add(stats[t]);
+	}
+	return total;
+}
+
+/**
+ * @brief List the regular files of a directory, sorted
+ */
+static bool listFiles(const std::string &directory, std::vector<std::string> &files)
+{
+	DIR *dir = opendir(directory.c_str());
+	struct dirent *entry;
+
+	if (dir == NULL)
+	{
+		return false;
+	}
+	while ((entry = readdir(dir)) != NULL)
+	{
+		std::string path = directory + "/" + entry->d_name;
+		struct stat info;
+
+		if ((stat(path.c_str(), &info) == 0) && S_ISREG(info.st_mode))
+		{
+			files.push_back(path);
+		}
+	}
+	closedir(dir);
+	std::sort(files.begin(), files.end());
+	return true;
+}
+
+/******************************************************************************
+ * Synthetic fleet
+ ******************************************************************************/
+
+//! @brief Addresses of the images in a generated dump
+static const uint16_t GENERATED_SETTINGS = 0;
+static const uint16_t GENERATED_SPARSE = 256;
+
+/**
+ * @brief Write a synthetic fleet of dumps with the library on the simulated EEPROM
+ *
+ * One in 20 devices is erased, one has a corrupted settings byte, and one has an out-of-range time zone with a
+ * valid checksum; the rest are valid.
+ */
+static bool generateFleet(const std::string &directory, uint32_t count, size_t dumpSize)
+{
+	mkdir(directory.c_str(), 0755);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		char name[64];
+		std::mt19937 generator(i);
+
+		EEPROM.resize(dumpSize);
+		if (i % 20 != 0)
+		{
+			UserSettingsClass settings;
+			UserSettingsClass sparse(true);
+
+			settings.begin(GENERATED_SETTINGS);
+			snprintf(name, sizeof(name), "device-%05u", (unsigned)i);
+			settings.setHostName(name);
+			settings.setTimeZone((float)(int)(generator() % 27) - 12);
+			settings.setAntennaType((i & 1) ? ANT_EXTERNAL : ANT_AUTO);
+			sparse.begin(GENERATED_SPARSE);
+			sparse.setDSTEnabled(true);
+
+			if (i % 20 == 1)
+			{
+				EEPROM.data()[GENERATED_SETTINGS + 2 + generator() % sizeof(SettingsObject)] ^= 0x10;
+			}
+			else if (i % 20 == 2)
+			{
+				EEPROM_Class<SettingsObject> raw;
+				SettingsObject object;
+
+				raw.begin(GENERATED_SETTINGS, object);
+				object.timeZone = 99;
+				raw.writeObject(object);
+			}
+		}
+
+		snprintf(name, sizeof(name), "/device-%05u.bin", (unsigned)i);
+		FILE *file = fopen((directory + name).c_str(), "wb");
+		if ((file == NULL) || (fwrite(EEPROM.data(), 1, EEPROM.length(), file) != EEPROM.length()))
+		{
+			perror((directory + name).c_str());
+			if (file != NULL)
+			{
+				fclose(file);
+			}
+			return false;
+		}
+		fclose(file);
+	}
+	printf("Generated %u dumps of %u bytes: settings@%u, sparse-settings@%u\n\n", (unsigned)count, (unsigned)dumpSize,
+		   (unsigned)GENERATED_SETTINGS, (unsigned)GENERATED_SPARSE);
+	return true;
+}
+
+/******************************************************************************
+ * Report
+ ******************************************************************************/
+
+static void report(const ScanStats &stats, const std::vector<LayoutSpec> &layouts, double seconds, size_t threads,
+				   const ScanKernel &kernel, uint32_t repeats)
+{
+	printf("Scanned %llu dumps (%.2f MB) in %.3f s: %.2f GB/s, %u threads (%llu steals), %s kernel\n",
+		   (unsigned long long)stats.files / repeats, stats.bytes / repeats / 1e6, seconds / repeats,
+		   stats.bytes / seconds / 1e9, (unsigned)threads, (unsigned long long)stats.steals, kernel.name);
+	printf("Dumps: %llu healthy, %llu with problems, %llu unreadable; %.1f%% of bytes erased\n\n",
+		   (unsigned long long)stats.healthy / repeats, (unsigned long long)(stats.files - stats.healthy) / repeats,
+		   (unsigned long long)stats.unreadable / repeats, stats.bytes ? 100.0 * stats.erasedBytes / stats.bytes : 0.0);
+
+	printf("%-24s", "layout");
+	for (size_t s = 0; s < IMAGE_STATUS_COUNT; s++)
+	{
+		printf(" %13s", statusNames[s]);
+	}
+	printf("\n");
+	for (size_t l = 0; l < layouts.size(); l++)
+	{
+		printf("%-24s", layouts[l].label.c_str());
+		for (size_t s = 0; s < IMAGE_STATUS_COUNT; s++)
+		{
+			printf(" %13llu", (unsigned long long)stats.layouts[l].status[s] / repeats);
+		}
+		printf("\n");
+		for (size_t f = 0; f < layouts[l].type->fieldCount; f++)
+		{
+			if (stats.layouts[l].invalidFields[f] != 0)
+			{
+				printf("    %-20s %llu invalid\n", layouts[l].type->fields[f].name,
+					   (unsigned long long)stats.layouts[l].invalidFields[f] / repeats);
+			}
+		}
+	}
+	for (size_t p = 0; p < stats.problems.size(); p++)
+	{
+		printf("%s\n", stats.problems[p].c_str());
+	}
+}
+
+static void usage(const char *program)
+{
+	fprintf(stderr, "usage: %s [-t layout]... [-j threads] [-k avx2|sse2|swar] [-r repeats] [-v] [-G count [-s dump size]] DIR\n", program);
+	fprintf(stderr, "layouts: settings@ADDR, sparse-settings@ADDR, raw:SIZE@ADDR (default settings@0)\n");
+}
+
+int main(int argc, char **argv)
+{
+	std::vector<LayoutSpec> layouts;
+	const ScanKernel *kernel = NULL;
+	size_t threads = max(std::thread::hardware_concurrency(), 1U);
+	uint32_t repeats = 1;
+	uint32_t generate = 0;
+	size_t dumpSize = 4096;
+	bool verbose = false;
+	int option;
+
+	while ((option = getopt(argc, argv, "t:j:k:r:vG:s:")) != -1)
+	{
+		switch (option)
+		{
+		case 't':
+		{
+			LayoutSpec spec;
+			if (!parseLayout(optarg, spec))
+			{
+				fprintf(stderr, "%s: unknown or incomplete layout '%s'\n", argv[0], optarg);
+				usage(argv[0]);
+				return 2;
+			}
+			layouts.push_back(spec);
+			break;
+		}
+		case 'j':
+			threads = max(strtoul(optarg, NULL, 0), 1UL);
+			break;
+		case 'k':
+			for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+			{
+				if ((strcmp(optarg, kernels[k].name) == 0) && kernels[k].supported())
+				{
+					kernel = &kernels[k];
+				}
+			}
+			if (kernel == NULL)
+			{
+				fprintf(stderr, "%s: kernel '%s' not available\n", argv[0], optarg);
+				return 2;
+			}
+			break;
+		case 'r':
+			repeats = max(strtoul(optarg, NULL, 0), 1UL);
+			break;
+		case 'v':
+			verbose = true;
+			break;
+		case 'G':
+			generate = strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			dumpSize = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			usage(argv[0]);
+			return 2;
+		}
+	}
+	if (optind != argc - 1)
+	{
+		usage(argv[0]);
+		return 2;
+	}
+	std::string directory(argv[optind]);
+
+	if (layouts.empty())
+	{
+		LayoutSpec spec;
+		parseLayout("settings@0", spec);
+		layouts.push_back(spec);
+	}
+	for (size_t k = 0; (kernel == NULL) && (k < sizeof(kernels) / sizeof(kernels[0])); k++)
+	{
+		if (kernels[k].supported())
+		{
+			kernel = &kernels[k];
+		}
+	}
+	if (!checkKernel(*kernel))
+	{
+		fprintf(stderr, "%s: %s kernel does not match EEPROM_Checksum\n", argv[0], kernel->name);
+		return 3;
+	}
+
+	if ((generate != 0) && ((dumpSize < GENERATED_SPARSE + 64) || !generateFleet(directory, generate, dumpSize)))
+	{
+		fprintf(stderr, "%s: cannot generate the fleet in %s\n", argv[0], directory.c_str());
+		return 2;
+	}
+
+	std::vector<std::string> files;
+	if (!listFiles(directory, files))
+	{
+		fprintf(stderr, "%s: %s: %s\n", argv[0], directory.c_str(), strerror(errno));
+		return 2;
+	}
+
+	ScanContext context = {&files, &layouts, kernel, verbose};
+	ScanStats total;
+	total.layouts.assign(layouts.size(), LayoutStats());
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (uint32_t r = 0; r < repeats; r++)
+	{
+		total.add(scan(context, threads));
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	// One line per problem, by file, however many repeats found it
+	std::sort(total.problems.begin(), total.problems.end());
+	total.problems.erase(std::unique(total.problems.begin(), total.problems.end()), total.problems.end());
+	report(total, layouts, seconds, threads, *kernel, repeats);
+	return (total.healthy == total.files) && (total.unreadable == 0) ? 0 : 1;
+}
@@ -0,0 +1,587 @@
+/**
+ * @file endurance.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Fleet endurance simulator: time to first wear-out failure of settings storage strategies
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "UserSettingsClass.h"
+#include "EEPROM_RingLog.h"
+#include "EEPROM_Endurance.h"
+
+/**
+ * @details
+ *
+ * Simulates a fleet of devices, each storing its settings with one of three strategies, on the real classes:
+ * 	- full: UserSettingsClass, the whole image rewritten on every change
+ * 	- sparse: UserSettingsClass in overlay mode, only the chunks that differ from the defaults
+ * 	- ringLog: EEPROM_RingLog of SettingsObject records, one appended per change (RING_SLOTS slots)
+ *
+ * Each device has its own change rate (log-normal around the median, -r) and makes -c setting changes on the
+ * simulated EEPROM, which counts the writes to every cell and, with its flash model, the emulation
+ * records appended. The measured per-cell rates are extrapolated to failure:
+ * 	- Byte EEPROM: every written cell gets a random endurance (Weibull, characteristic life EEPROM_CELL_ENDURANCE,
+ * 	  shape -b), and the device fails when its first cell wears out.
+ * 	- Flash emulated EEPROM: page erases follow from the records appended and the free records per page; each of
+ * 	  FLASH_PAGES pages gets a random endurance (Weibull, FLASH_ENDURANCE), and the first page to wear out fails
+ * 	  the device.
+ *
+ * The changes are random, or with -w a recorded workload: a setter log captured from a device, one change per
+ * line as "seconds,member,value" (time since the start of the capture, a member name as in USER_SETTINGS() and
+ * the value as text, parsed and range-checked by EEPROM_Fields::parse(); empty lines and lines starting with #
+ * are ignored). Each device replays the log from its own random starting line, wrapping around, through the
+ * real setters, so a change to the value a setting already has writes nothing, as on the device. Unless -r is
+ * given, the median change rate is the rate of the log. Binary operation traces (EEPROM_TraceFormat) hold no
+ * setting values, so they cannot drive the setters and are not accepted.
+ *
+ * Devices are dealt to worker threads from a shared counter; each device draws from its own generator, so the
+ * results do not depend on the number of threads. The fleet time to first failure is printed at several
+ * percentiles, next to the EEPROM_Endurance projection for a device at the median rate, with the simulation
+ * throughput. The projection assumes every cell has exactly the rated endurance, so it is well above the
+ * simulated median, by the most for the ring log, whose writes are shared by the most cells.
+ *
+ * Usage: endurance [-d devices] [-c changes per device] [-r median changes/day] [-b Weibull shape] [-w workload] [-j threads] [-s seed]
+ */
+
+//! @brief Rated (characteristic) endurance of a byte EEPROM cell
+static const double EEPROM_CELL_ENDURANCE = 100000;
+
+//! @brief Rated (characteristic) erase endurance of a flash page
+static const double FLASH_ENDURANCE = 10000;
+
+//! @brief Flash pages used by the emulation
+static const uint32_t FLASH_PAGES = 2;
+
+//! @brief Flash emulation geometry: 2 data bytes per record, 2 bytes of record header, records of unchanged data skipped
+static const HostFlashGeometry FLASH_GEOMETRY = {2, 16384, 2, true};
+
+//! @brief Emulated EEPROM size (bytes), as on Gen3 devices
+static const size_t EEPROM_SIZE = 4096;
+
+//! @brief Slots in the ring log strategy
+static const size_t RING_SLOTS = 16;
+
+//! @brief Spread of the device change rates (sigma of the natural log)
+static const double RATE_SIGMA = 1.0;
+
+/**
+ * @brief Storage strategies
+ */
+enum Strategy
+{
+	STRATEGY_FULL,
+	STRATEGY_SPARSE,
+	STRATEGY_RING,
+	STRATEGY_COUNT
+};
+
+//! @brief Strategy names
+static const char *const strategyNames[STRATEGY_COUNT] = {"full", "sparse", "ringLog"};
+
+/**
+ * @brief One change of a recorded workload
+ */
+struct RecordedChange
+{
+	const EEPROM_Field *field;
+	std::string value;
+};
+
+/**
+ * @brief Simulation parameters
+ */
+struct EnduranceConfig
+{
+	uint32_t devices;
+	uint32_t changes;
+	double changesPerDay;
+	double shape;
+	uint32_t seed;
+	/** Recorded workload, empty for random changes */
+	std::vector<RecordedChange> recorded;
+};
+
+/**
+ * @brief Result of one device: years to first failure on each medium
+ */
+struct DeviceResult
+{
+	double eepromYears;
+	double flashYears;
+};
+
+/**
+ * @brief Apply one random setting change, to the RAM object and through the setter
+ *
+ * @param random generator
+ * @param object settings, changed in place
+ * @param settings settings class to set through, NULL for none
+ */
+static void randomChange(std::mt19937_64 &random, SettingsObject &object, UserSettingsClass *settings)
+{
+	switch (random() % 5)
+	{
+	case 0:
+		object.timeZone = (float)(random() % 27) - 12;
+		if (settings != NULL)
+		{
+			settings->setTimeZone(object.timeZone);
+		}
+		break;
+
+	case 1:
+		object.dstOffset = (float)(random() % 5) * 0.5f;
+		if (settings != NULL)
+		{
+			settings->setDstOffset(object.dstOffset);
+		}
+		break;
+
+	case 2:
+		object.dstEnabled = !object.dstEnabled;
+		if (settings != NULL)
+		{
+			settings->setDSTEnabled(object.dstEnabled);
+		}
+		break;
+
+	case 3:
+	{
+		size_t length = 1 + random() % (sizeof(object.hostName) - 1);
+
+		memset(object.hostName, 0, sizeof(object.hostName));
+		for (size_t i = 0; i < length; i++)
+		{
+			object.hostName[i] = 'a' + random() % 26;
+		}
+		if (settings != NULL)
+		{
+			settings->setHostName(object.hostName);
+		}
+		break;
+	}
+
+	default:
+	{
+		static const WLanSelectAntenna_TypeDef antennas[] = {ANT_INTERNAL, ANT_EXTERNAL, ANT_AUTO};
+
+		object.antennaType = antennas[random() % 3];
+		if (settings != NULL)
+		{
+			settings->setAntennaType(object.antennaType);
+		}
+		break;
+	}
+	}
+}
+
+//! @cond
+#define ENDURANCE_SET_FLOAT(member, getter, setter, defaultValue, label, format, minValue, maxValue) \
+	if (field.offset == offsetof(SettingsObject, member))                                            \
+		settings->setter(object.member);
+#define ENDURANCE_SET_BOOL(member, getter, setter, defaultValue, label) \
+	if (field.offset == offsetof(SettingsObject, member))               \
+		settings->setter(object.member);
+#define ENDURANCE_SET_STRING(member, size, getter, setter, defaultValue, label) \
+	if (field.offset == offsetof(SettingsObject, member))                       \
+		settings->setter(object.member);
+#define ENDURANCE_SET_ENUM(type, member, getter, setter, defaultValue, label, names) \
+	if (field.offset == offsetof(SettingsObject, member))                           \
+		settings->setter(object.member);
+//! @endcond
+
+/**
+ * @brief Apply one recorded change, to the RAM object and through the setter
+ *
+ * @param change recorded change, validated when loaded
+ * @param object settings, changed in place
+ * @param settings settings class to set through, NULL for none
+ */
+static void recordedChange(const RecordedChange &change, SettingsObject &object, UserSettingsClass *settings)
+{
+	const EEPROM_Field &field = *change.field;
+
+	EEPROM_Fields::parse(field, change.value.c_str(), &object);
+	if (settings != NULL)
+	{
+		USER_SETTINGS(ENDURANCE_SET_FLOAT, ENDURANCE_SET_BOOL, ENDURANCE_SET_STRING, ENDURANCE_SET_ENUM)
+	}
+}
+
+/**
+ * @brief Make the configured number of changes with one strategy: random, or from the recorded workload
+ *
+ * @param strategy storage strategy
+ * @param config simulation parameters
+ * @param random generator
+ */
+static void runChanges(Strategy strategy, const EnduranceConfig &config, std::mt19937_64 &random)
+{
+	SettingsObject object = UserSettingsClass::defaultSettings;
+	size_t line = config.recorded.empty() ? 0 : random() % config.recorded.size();
+	EEPROM_RingLog<SettingsObject, 1> log(RING_SLOTS);
+	UserSettingsClass settings(strategy == STRATEGY_SPARSE);
+
+	if (strategy == STRATEGY_RING)
+	{
+		log.begin(0);
+	}
+	else
+	{
+		settings.begin(0);
+	}
+	EEPROM.resetCounters();
+
+	for (uint32_t i = 0; i < config.changes; i++)
+	{
+		UserSettingsClass *target = (strategy == STRATEGY_RING) ? NULL : &settings;
+
+		if (config.recorded.empty())
+		{
+			randomChange(random, object, target);
+		}
+		else
+		{
+			recordedChange(config.recorded[line], object, target);
+			line = (line + 1) % config.recorded.size();
+		}
+		if (strategy == STRATEGY_RING)
+		{
+			log.append(object);
+		}
+	}
+}
+
+/**
+ * @brief Load a recorded workload (setter log)
+ *
+ * @param path file name
+ * @param config receives the changes, and the median change rate if rateGiven is false
+ * @param rateGiven true if the change rate was set with -r
+ * @return true loaded
+ * @return false file missing or invalid (reported)
+ */
+static bool loadWorkload(const char *path, EnduranceConfig &config, bool rateGiven)
+{
+	FILE *input = fopen(path, "r");
+	char text[256];
+	unsigned lineNumber = 0;
+	double first = 0;
+	double last = 0;
+
+	if (input == NULL)
+	{
+		perror(path);
+		return false;
+	}
+	while (fgets(text, sizeof(text), input) != NULL)
+	{
+		char *seconds = text;
+		char *member = strchr(seconds, ',');
+		char *value = (member != NULL) ? strchr(member + 1, ',') : NULL;
+		RecordedChange change = {NULL, ""};
+		SettingsObject scratch = UserSettingsClass::defaultSettings;
+
+		lineNumber++;
+		text[strcspn(text, "\r\n")] = 0;
+		if ((text[0] == 0) || (text[0] == '#'))
+		{
+			continue;
+		}
+		if (value == NULL)
+		{
+			fprintf(stderr, "%s:%u: expected seconds,member,value\n", path, lineNumber);
+			fclose(input);
+			return false;
+		}
+		*member++ = 0;
+		*value++ = 0;
+		for (size_t f = 0; f < UserSettingsClass::fieldCount; f++)
+		{
+			if (strcmp(member, UserSettingsClass::fields[f].name) == 0)
+			{
+				change.field = &UserSettingsClass::fields[f];
+			}
+		}
+		if ((change.field == NULL) || !EEPROM_Fields::parse(*change.field, value, &scratch))
+		{
+			fprintf(stderr, "%s:%u: invalid %s \"%s\"\n", path, lineNumber, member, value);
+			fclose(input);
+			return false;
+		}
+		change.value = value;
+		if (config.recorded.empty())
+		{
+			first = strtod(seconds, NULL);
+		}
+		last = strtod(seconds, NULL);
+		config.recorded.push_back(change);
+	}
+	fclose(input);
+
+	if (config.recorded.empty())
+	{
+		fprintf(stderr, "%s: no changes\n", path);
+		return false;
+	}
+	if (!rateGiven)
+	{
+		if (last <= first)
+		{
+			fprintf(stderr, "%s: log spans no time, give the change rate with -r\n", path);
+			return false;
+		}
+		config.changesPerDay = config.recorded.size() * 86400.0 / (last - first);
+	}
+	return true;
+}
+
+/**
+ * @brief Simulate one device
+ *
+ * @param strategy storage strategy
+ * @param device device number
+ * @param config simulation parameters
+ * @return DeviceResult years to first failure
+ */
+static DeviceResult simulateDevice(Strategy strategy, uint32_t device, const EnduranceConfig &config)
+{
+	std::mt19937_64 random(((uint64_t)config.seed << 32) ^ ((uint64_t)strategy << 28) ^ device);
+	std::lognormal_distribution<double> rates(log(config.changesPerDay), RATE_SIGMA);
+	double changesPerDay = rates(random);
+	DeviceResult result;
+
+	EEPROM.resize(EEPROM_SIZE);
+	EEPROM.setFlashModel(FLASH_GEOMETRY);
+	runChanges(strategy, config, random);
+
+	// Byte EEPROM: first cell to reach its own endurance
+	std::weibull_distribution<double> cellEndurance(config.shape, EEPROM_CELL_ENDURANCE);
+	const std::vector<uint32_t> &cellWrites = EEPROM.getCellWrites();
+	double firstDays = 1e300;
+
+	for (size_t cell = 0; cell < cellWrites.size(); cell++)
+	{
+		if (cellWrites[cell] != 0)
+		{
+			double writesPerDay = (double)cellWrites[cell] / config.changes * changesPerDay;
+			firstDays = min(firstDays, cellEndurance(random) / writesPerDay);
+		}
+	}
+	result.eepromYears = firstDays / 365.25;
+
+	// Flash emulation: each page is erased once per FLASH_PAGES compactions
+	size_t pageRecords = FLASH_GEOMETRY.pageSize / (FLASH_GEOMETRY.recordSize + FLASH_GEOMETRY.recordOverhead);
+	size_t liveRecords = EEPROM_SIZE / FLASH_GEOMETRY.recordSize;
+	double erasesPerDay = (double)EEPROM.getRecordsAppended() / config.changes * changesPerDay / (pageRecords - liveRecords);
+	std::weibull_distribution<double> pageEndurance(config.shape, FLASH_ENDURANCE);
+
+	firstDays = 1e300;
+	for (uint32_t page = 0; page < FLASH_PAGES; page++)
+	{
+		firstDays = min(firstDays, pageEndurance(random) / (erasesPerDay / FLASH_PAGES));
+	}
+	result.flashYears = firstDays / 365.25;
+	return result;
+}
+
+/**
+ * @brief Worker thread: simulate devices from the shared counter until the fleet is done
+ */
+static void worker(Strategy strategy, std::atomic<uint32_t> &next, const EnduranceConfig &config,
+				   std::vector<DeviceResult> &results)
+{
+	uint32_t device;
+
+	while ((device = next++) < config.devices)
+	{
+		results[device] = simulateDevice(strategy, device, config);
+	}
+}
+
+/**
+ * @brief EEPROM_Endurance projection for a device at the median change rate, from one uncut run of the strategy
+ *
+ * @param strategy storage strategy
+ * @param config simulation parameters
+ * @param eepromYears receives the byte EEPROM projection
+ * @param flashYears receives the flash emulation projection
+ */
+static void project(Strategy strategy, const EnduranceConfig &config, double &eepromYears, double &flashYears)
+{
+	std::mt19937_64 random(config.seed);
+	EEPROM_Workload workload;
+
+	EEPROM.resize(EEPROM_SIZE);
+	runChanges(strategy, config, random);
+
+	// Byte EEPROM: records are bytes
+	workload.commitsPerDay = config.changesPerDay;
+	workload.recordsPerCommit = (double)EEPROM.getWrites() / config.changes;
+	if (strategy == STRATEGY_RING)
+	{
+		workload.spread = RING_SLOTS;
+		workload.hottestWritesPerCommit = 1;
+		workload.footprint = sizeof(SettingsObject);
+	}
+	else
+	{
+		workload.spread = 1;
+		workload.hottestWritesPerCommit = UserSettingsClass::CHECKSUM_WRITES;
+		workload.footprint = sizeof(SettingsObject) + sizeof(uint16_t);
+	}
+	eepromYears = EEPROM_Endurance(EEPROM_CELL_ENDURANCE).years(workload);
+
+	// Flash emulation: emulation records appended
+	EEPROM.resize(EEPROM_SIZE);
+	EEPROM.setFlashModel(FLASH_GEOMETRY);
+	runChanges(strategy, config, random);
+	workload.recordsPerCommit = (double)EEPROM.getRecordsAppended() / config.changes;
+
+	EEPROM_Endurance flash(FLASH_ENDURANCE, FLASH_GEOMETRY.pageSize, FLASH_PAGES,
+						   FLASH_GEOMETRY.recordSize + FLASH_GEOMETRY.recordOverhead, EEPROM_SIZE / FLASH_GEOMETRY.recordSize);
+	flashYears = flash.years(workload);
+}
+
+/**
+ * @brief Value at a percentile of a sorted list
+ */
+static double percentile(const std::vector<double> &sorted, double percent)
+{
+	size_t index = (size_t)(percent * (sorted.size() - 1) / 100.0 + 0.5);
+	return sorted[min(index, sorted.size() - 1)];
+}
+
+/**
+ * @brief Print the time to first failure distribution of one strategy and medium
+ */
+static void report(const char *strategy, const char *medium, std::vector<double> years, double projected)
+{
+	static const double percents[] = {0.1, 1, 10, 50, 90};
+
+	std::sort(years.begin(), years.end());
+	printf("%-8s %-7s", strategy, medium);
+	for (size_t i = 0; i < sizeof(percents) / sizeof(percents[0]); i++)
+	{
+		printf(" %10.1f", percentile(years, percents[i]));
+	}
+	printf(" %12.1f\n", projected);
+}
+
+static void usage(const char *program)
+{
+	fprintf(stderr, "usage: %s [-d devices] [-c changes per device] [-r median changes/day] [-b Weibull shape] [-w workload] [-j threads] [-s seed]\n",
+			program);
+	exit(2);
+}
+
+int main(int argc, char **argv)
+{
+	EnduranceConfig config = {10000, 256, 24, 2.0, 1, std::vector<RecordedChange>()};
+	size_t threads = max(std::thread::hardware_concurrency(), 1U);
+	const char *workload = NULL;
+	bool rateGiven = false;
+	int option;
+
+	while ((option = getopt(argc, argv, "d:c:r:b:w:j:s:")) != -1)
+	{
+		switch (option)
+		{
+		case 'd':
+			config.devices = strtoul(optarg, NULL, 0);
+			break;
+		case 'c':
+			config.changes = strtoul(optarg, NULL, 0);
+			break;
+		case 'r':
+			config.changesPerDay = strtod(optarg, NULL);
+			rateGiven = true;
+			break;
+		case 'b':
+			config.shape = strtod(optarg, NULL);
+			break;
+		case 'w':
+			workload = optarg;
+			break;
+		case 'j':
+			threads = max(strtoul(optarg, NULL, 0), 1UL);
+			break;
+		case 's':
+			config.seed = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+	if ((optind != argc) || (config.devices == 0) || (config.changes == 0) || (config.changesPerDay <= 0) ||
+		(config.shape <= 0))
+	{
+		usage(argv[0]);
+	}
+	if ((workload != NULL) && !loadWorkload(workload, config, rateGiven))
+	{
+		return 2;
+	}
+
+	if (workload != NULL)
+	{
+		printf("Recorded workload %s: %u changes, replayed from a random line on each device\n", workload,
+			   (unsigned)config.recorded.size());
+	}
+	printf("%u devices per strategy, %u changes each, median %.1f changes/day (log-normal, sigma %.1f), Weibull shape %.1f\n",
+		   (unsigned)config.devices, (unsigned)config.changes, config.changesPerDay, RATE_SIGMA, config.shape);
+	printf("Years to first failure at fleet percentile, and the EEPROM_Endurance projection at the median rate\n");
+	printf("(projected: one device with every cell at the rated endurance, not a fleet median)\n\n");
+	printf("%-8s %-7s %10s %10s %10s %10s %10s %12s\n", "strategy", "medium", "p0.1", "p1", "p10", "p50", "p90",
+		   "projected");
+
+	uint64_t commits = 0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int s = 0; s < STRATEGY_COUNT; s++)
+	{
+		Strategy strategy = (Strategy)s;
+		std::atomic<uint32_t> next(0);
+		std::vector<DeviceResult> results(config.devices);
+		std::vector<std::thread> pool;
+
+		for (size_t t = 0; t < threads; t++)
+		{
+			pool.push_back(std::thread(worker, strategy, std::ref(next), std::cref(config), std::ref(results)));
+		}
+		for (size_t t = 0; t < threads; t++)
+		{
+			pool[t].join();
+		}
+		commits += (uint64_t)config.devices * config.changes;
+
+		std::vector<double> eepromYears(config.devices);
+		std::vector<double> flashYears(config.devices);
+		for (uint32_t d = 0; d < config.devices; d++)
+		{
+			eepromYears[d] = results[d].eepromYears;
+			flashYears[d] = results[d].flashYears;
+		}
+
+		double projectedEeprom;
+		double projectedFlash;
+		project(strategy, config, projectedEeprom, projectedFlash);
+		report(strategyNames[s], "eeprom", eepromYears, projectedEeprom);
+		report(strategyNames[s], "flash", flashYears, projectedFlash);
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	printf("\n%llu simulated changes in %.2f s, %u threads: %.0f changes/s\n", (unsigned long long)commits, seconds,
+		   (unsigned)threads, commits / seconds);
+	return 0;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file flash_model.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Flash emulation model: page erases caused by settings changes, packed vs record-aligned layout
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include <unistd.h>
+#include "EEPROM_Class.h"
+
+/**
+ * @details
+ *
+ * Runs the same settings-change workload on EEPROM_Class objects with the default (packed) layout and with
+ * EEPROM_RecordLayout, on the simulated EEPROM with its flash emulation model enabled, and prints the records
+ * appended and page erases per layout. Both emulation models are run: one that appends every record a write
+ * overlaps, and one that skips records whose contents do not change.
+ *
+ * The workload is two objects placed back-to-back from an unaligned start address (as a sketch that adds
+ * getSize() to its addresses would place them), with one 4-byte item of one object changed per commit (as a
+ * setter does). It is run for a range of object sizes, including that of SettingsObject (48 bytes).
+ *
+ * Usage: flash_model [-n changes] [-s start address] [-r record size] [-p page size] [-o record overhead]
+ */
+
+/**
+ * @brief Model results for one layout
+ */
+struct ModelResult
+{
+	uint64_t records;
+	uint64_t pageErases;
+};
+
+/**
+ * @brief Data object of a given size
+ *
+ * @tparam SIZE object size (bytes)
+ */
+template <size_t SIZE>
+struct ModelObject
+{
+	uint8_t data[SIZE];
+};
+
+/**
+ * @brief Change one 4-byte item of the object, cycling through the items
+ *
+ * @param object Data object
+ * @param change Change number
+ */
+template <size_t SIZE>
+static void changeItem(ModelObject<SIZE> &object, uint32_t change)
+{
+	size_t offset = (change * 4) % (SIZE & ~(size_t)3);
+
+	memcpy(&object.data[offset], &change, 4);
+}
+
+/**
+ * @brief Run the workload with one layout
+ *
+ * @tparam SIZE object size (bytes)
+ * @tparam LAYOUT layout policy
+ * @param geometry flash geometry
+ * @param start address of the first object
+ * @param changes number of setting changes
+ * @return ModelResult counts
+ */
+template <size_t SIZE, class LAYOUT>
+static ModelResult runModel(const HostFlashGeometry &geometry, uint16_t start, uint32_t changes)
+{
+	ModelObject<SIZE> objects[2];
+	EEPROM_Class<ModelObject<SIZE>, LAYOUT> images[2];
+	ModelResult result;
+	size_t address = start;
+
+	memset(objects, 0, sizeof(objects));
+	EEPROM.resize(EEPROM.length());
+	EEPROM.setFlashModel(geometry);
+	for (int i = 0; i < 2; i++)
+	{
+		images[i].begin(address, objects[i]);
+		images[i].writeObject(objects[i]);
+		address += images[i].getSize();
+		images[i].resetCounters();
+	}
+	EEPROM.resetCounters();
+
+	for (uint32_t change = 0; change < changes; change++)
+	{
+		int i = change & 1;
+		changeItem(objects[i], change / 2);
+		images[i].writeObject(objects[i]);
+	}
+
+	result.records = EEPROM.getRecordsAppended();
+	result.pageErases = EEPROM.getPageErases();
+	return result;
+}
+
+/**
+ * @brief Run and print both layouts for one object size
+ *
+ * @tparam SIZE object size (bytes)
+ * @param geometry flash geometry
+ * @param start address of the first object
+ * @param changes number of changes
+ */
+template <size_t SIZE>
+static void compareLayouts(const HostFlashGeometry &geometry, uint16_t start, uint32_t changes)
+{
+	ModelResult before = runModel<SIZE, EEPROM_DefaultLayout>(geometry, start, changes);
+	ModelResult after = runModel<SIZE, EEPROM_RecordLayout<16> >(geometry, start, changes);
+
+	printf("%-11s %6u %16.2f %16.2f %14llu %14llu %9.1f%%\n", geometry.skipUnchanged ? "changed" : "overlapped", (unsigned)SIZE,
+		   (double)before.records / changes, (double)after.records / changes, (unsigned long long)before.pageErases,
+		   (unsigned long long)after.pageErases,
+		   before.pageErases ? 100.0 * ((double)before.pageErases - after.pageErases) / before.pageErases : 0.0);
+}
+
+int main(int argc, char **argv)
+{
+	HostFlashGeometry geometry = {16, 16384, 4, false};
+	uint32_t changes = 100000;
+	uint16_t start = 3;
+	int option;
+
+	while ((option = getopt(argc, argv, "n:s:r:p:o:")) != -1)
+	{
+		switch (option)
+		{
+		case 'n':
+			changes = strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			start = strtoul(optarg, NULL, 0);
+			break;
+		case 'r':
+			geometry.recordSize = strtoul(optarg, NULL, 0);
+			break;
+		case 'p':
+			geometry.pageSize = strtoul(optarg, NULL, 0);
+			break;
+		case 'o':
+			geometry.recordOverhead = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-n changes] [-s start address] [-r record size] [-p page size] [-o record overhead]\n", argv[0]);
+			return 2;
+		}
+	}
+	if (geometry.recordSize != 16)
+	{
+		fprintf(stderr, "%s: the aligned layout is built for 16-byte records, -r only changes the model\n", argv[0]);
+	}
+
+	printf("%u changes, 2 objects from address %u, %u-byte records, %u-byte pages\n\n", (unsigned)changes,
+		   (unsigned)start, (unsigned)geometry.recordSize, (unsigned)geometry.pageSize);
+	printf("%-11s %6s %16s %16s %14s %14s %10s\n", "records", "size", "packed rec/chg", "aligned rec/chg",
+		   "packed erases", "aligned erases", "saving");
+	for (int skip = 0; skip < 2; skip++)
+	{
+		geometry.skipUnchanged = skip;
+		compareLayouts<14>(geometry, start, changes);
+		compareLayouts<30>(geometry, start, changes);
+		compareLayouts<48>(geometry, start, changes);
+		compareLayouts<62>(geometry, start, changes);
+		compareLayouts<126>(geometry, start, changes);
+	}
+	return 0;
+}
@@ -0,0 +1,343 @@
+/**
+ * @file powerloss.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Power-loss torture test: UserSettingsClass updates cut at every byte, on every core
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "UserSettingsClass.h"
+
+/**
+ * @details
+ *
+ * The host counterpart of the powerLossTest example. Each round picks an old and a new settings value (alternately
+ * a time zone and a random-length hostname, from a per-round seed so that any round can be rerun alone). The old
+ * value is committed and the EEPROM saved; then, for every byte index of the update, the EEPROM is restored, the
+ * simulated EEPROM cuts power just before that byte write (EEPROMClass::cutAfter()), and a fresh UserSettingsClass
+ * begin() loads what was left. Each cut is classified as in the example:
+ * 	- old: the previous settings were loaded
+ * 	- new: the updated settings were loaded
+ * 	- defaults: the checksum was invalid and begin() reset the settings to defaults
+ * 	- corrupt: the checksum was valid but the settings match neither value (silent corruption)
+ *
+ * Rounds are dealt to worker threads from a shared counter; each thread simulates its own EEPROM. Full and sparse
+ * (overlay) storage are tested. The totals, the cuts per second and the first few corrupt cuts (round and byte
+ * index) are printed, and the exit status is 1 if any cut was silently corrupt.
+ *
+ * Usage: powerloss [-n rounds] [-j threads] [-s seed]
+ */
+
+/**
+ * @brief Cut outcomes
+ */
+enum Outcome
+{
+	OUTCOME_OLD,
+	OUTCOME_NEW,
+	OUTCOME_DEFAULTS,
+	OUTCOME_CORRUPT,
+	OUTCOME_COUNT
+};
+
+//! @brief Outcome names
+static const char *const outcomeNames[OUTCOME_COUNT] = {"old", "new", "defaults", "corrupt"};
+
+//! @brief Corrupt cuts listed in the report
+static const size_t MAX_LISTED = 8;
+
+//! @brief Simulated EEPROM size (bytes), enough for the settings in either mode
+static const size_t EEPROM_SIZE = 256;
+
+/**
+ * @brief A corrupt cut, to rerun
+ */
+struct CorruptCut
+{
+	uint32_t round;
+	bool sparse;
+	uint32_t cut;
+};
+
+/**
+ * @brief Totals of one worker thread
+ */
+struct PowerLossStats
+{
+	uint64_t counts[OUTCOME_COUNT];
+	uint64_t rounds;
+	std::vector<CorruptCut> corrupt;
+
+	PowerLossStats() : counts(), rounds(0) {}
+
+	void add(const PowerLossStats &other)
+	{
+		for (size_t i = 0; i < OUTCOME_COUNT; i++)
+		{
+			counts[i] += other.counts[i];
+		}
+		rounds += other.rounds;
+		corrupt.insert(corrupt.end(), other.corrupt.begin(), other.corrupt.end());
+	}
+};
+
+/**
+ * @brief Settings values of one side of an update
+ */
+struct SettingsValue
+{
+	float timeZone;
+	char hostName[32];
+};
+
+/**
+ * @brief Next pseudo-random number (xorshift32)
+ */
+static uint32_t nextRandom(uint32_t &seed)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+/**
+ * @brief Pick the old and new values of a round. Even rounds change the time zone, odd rounds the hostname.
+ *
+ * @param round round number
+ * @param baseSeed seed of the run
+ * @param before settings before the update
+ * @param after settings after the update
+ */
+static void pickRound(uint32_t round, uint32_t baseSeed, SettingsValue &before, SettingsValue &after)
+{
+	uint32_t seed = (baseSeed ^ (round * 0x9E3779B9u)) | 1;
+	size_t length = 1 + nextRandom(seed) % (sizeof(before.hostName) - 1);
+
+	before.timeZone = (float)(nextRandom(seed) % 27) - 12;
+	for (size_t i = 0; i < length; i++)
+	{
+		before.hostName[i] = 'a' + nextRandom(seed) % 26;
+	}
+	before.hostName[length] = 0;
+	after = before;
+
+	if (round & 1)
+	{
+		// Random length, so that both short and long names are cut
+		length = 1 + nextRandom(seed) % (sizeof(after.hostName) - 1);
+		for (size_t i = 0; i < length; i++)
+		{
+			after.hostName[i] = 'a' + nextRandom(seed) % 26;
+		}
+		after.hostName[length] = 0;
+	}
+	else
+	{
+		do
+		{
+			after.timeZone = (float)(nextRandom(seed) % 27) - 12;
+		} while (after.timeZone == before.timeZone);
+	}
+}
+
+/**
+ * @brief Apply one side of an update
+ *
+ * @param settings settings, after begin()
+ * @param value new values
+ * @param hostName true to set the hostname, false for the time zone
+ */
+static void apply(UserSettingsClass &settings, const SettingsValue &value, bool hostName)
+{
+	if (hostName)
+	{
+		settings.setHostName(value.hostName);
+	}
+	else
+	{
+		settings.setTimeZone(value.timeZone);
+	}
+}
+
+/**
+ * @brief Check loaded settings against one side of an update
+ */
+static bool matches(UserSettingsClass &settings, const SettingsValue &value)
+{
+	return (settings.getTimeZone() == value.timeZone) && (strcmp(settings.getHostName(), value.hostName) == 0);
+}
+
+/**
+ * @brief Cut one update at every byte index
+ *
+ * @param round round number
+ * @param baseSeed seed of the run
+ * @param sparse overlay mode
+ * @param stats totals to update
+ */
+static void runRound(uint32_t round, uint32_t baseSeed, bool sparse, PowerLossStats &stats)
+{
+	SettingsValue before;
+	SettingsValue after;
+	std::vector<uint8_t> saved(EEPROM_SIZE);
+
+	pickRound(round, baseSeed, before, after);
+
+	// Commit the old value and keep the EEPROM contents, then count the byte writes of an uncut update
+	EEPROM.resize(EEPROM_SIZE);
+	{
+		UserSettingsClass settings(sparse);
+		settings.begin(0);
+		settings.setTimeZone(before.timeZone);
+		settings.setHostName(before.hostName);
+	}
+	memcpy(saved.data(), EEPROM.data(), EEPROM_SIZE);
+
+	uint32_t bytes;
+	{
+		UserSettingsClass settings(sparse);
+		settings.begin(0);
+		EEPROM.resetCounters();
+		apply(settings, after, round & 1);
+		bytes = EEPROM.getWrites();
+	}
+
+	for (uint32_t cut = 0; cut < bytes; cut++)
+	{
+		memcpy(EEPROM.data(), saved.data(), EEPROM_SIZE);
+		{
+			UserSettingsClass settings(sparse);
+			settings.begin(0);
+			EEPROM.cutAfter(cut);
+			try
+			{
+				apply(settings, after, round & 1);
+			}
+			catch (HostPowerCut &)
+			{
+			}
+			EEPROM.restorePower();
+		}
+
+		UserSettingsClass settings(sparse);
+		Outcome outcome;
+
+		if (!settings.begin(0))
+		{
+			outcome = OUTCOME_DEFAULTS;
+		}
+		else if (matches(settings, before))
+		{
+			outcome = OUTCOME_OLD;
+		}
+		else if (matches(settings, after))
+		{
+			outcome = OUTCOME_NEW;
+		}
+		else
+		{
+			outcome = OUTCOME_CORRUPT;
+			if (stats.corrupt.size() < MAX_LISTED)
+			{
+				CorruptCut corrupt = {round, sparse, cut};
+				stats.corrupt.push_back(corrupt);
+			}
+		}
+		stats.counts[outcome]++;
+	}
+	stats.rounds++;
+}
+
+/**
+ * @brief Worker thread: take rounds from the shared counter until all are done
+ */
+static void worker(std::atomic<uint32_t> &next, uint32_t rounds, uint32_t seed, PowerLossStats &stats)
+{
+	uint32_t round;
+
+	while ((round = next++) < rounds)
+	{
+		runRound(round, seed, false, stats);
+		runRound(round, seed, true, stats);
+	}
+}
+
+static void usage(const char *program)
+{
+	fprintf(stderr, "usage: %s [-n rounds] [-j threads] [-s seed]\n", program);
+	exit(2);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t rounds = 20000;
+	size_t threads = max(std::thread::hardware_concurrency(), 1U);
+	uint32_t seed = 0x12345678;
+	int option;
+
+	while ((option = getopt(argc, argv, "n:j:s:")) != -1)
+	{
+		switch (option)
+		{
+		case 'n':
+			rounds = strtoul(optarg, NULL, 0);
+			break;
+		case 'j':
+			threads = max(strtoul(optarg, NULL, 0), 1UL);
+			break;
+		case 's':
+			seed = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+	if (optind != argc)
+	{
+		usage(argv[0]);
+	}
+
+	std::atomic<uint32_t> next(0);
+	std::vector<PowerLossStats> stats(threads);
+	std::vector<std::thread> pool;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (size_t t = 0; t < threads; t++)
+	{
+		pool.push_back(std::thread(worker, std::ref(next), rounds, seed, std::ref(stats[t])));
+	}
+	PowerLossStats total;
+	for (size_t t = 0; t < threads; t++)
+	{
+		pool[t].join();
+		total.add(stats[t]);
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	uint64_t cuts = 0;
+	for (size_t i = 0; i < OUTCOME_COUNT; i++)
+	{
+		cuts += total.counts[i];
+	}
+	printf("%llu power cuts in %llu updates (full and sparse), %.2f s, %u threads: %.0f cuts/s\n\n", (unsigned long long)cuts,
+		   (unsigned long long)total.rounds, seconds, (unsigned)threads, cuts / seconds);
+	for (size_t i = 0; i < OUTCOME_COUNT; i++)
+	{
+		printf("%-8s %12llu %7.3f%%\n", outcomeNames[i], (unsigned long long)total.counts[i],
+			   cuts ? 100.0 * total.counts[i] / cuts : 0.0);
+	}
+	for (size_t i = 0; i < min(total.corrupt.size(), MAX_LISTED); i++)
+	{
+		printf("corrupt: round %u (%s) cut before byte %u\n", (unsigned)total.corrupt[i].round,
+			   total.corrupt[i].sparse ? "sparse" : "full", (unsigned)total.corrupt[i].cut);
+	}
+	return (total.counts[OUTCOME_CORRUPT] != 0) ? 1 : 0;
+}
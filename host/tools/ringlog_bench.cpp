@@ -0,0 +1,183 @@
+/**
+ * @file ringlog_bench.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Ring log benchmark: append throughput and boot-time head discovery
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include <unistd.h>
+#include <chrono>
+#include "EEPROM_RingLog.h"
+
+/**
+ * @details
+ *
+ * Append throughput: appends records to an EEPROM_RingLog on the simulated EEPROM for several batch sizes and
+ * prints the host time and the EEPROM bytes written per record. The bytes per record are what a device pays;
+ * the host time only compares the code paths.
+ *
+ * Head discovery: fills logs of several capacities to a range of states (partly filled, wrapped with the head
+ * at several positions, and with slot 0 torn so that begin() falls back to a full scan), then times begin()
+ * and counts the slots it reads, against the capacity a linear scan would read. Each begin() result is
+ * checked against the record count and next sequence number written.
+ *
+ * Usage: ringlog_bench [-n appends] [-r begin repeats]
+ */
+
+/**
+ * @brief Record type used for the benchmark (a timestamped two-channel sample)
+ */
+struct Sample
+{
+	uint32_t time;
+	float value[2];
+};
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * @brief Nanoseconds since a start time
+ */
+static double elapsedNs(Clock::time_point start)
+{
+	return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Time appends with one batch size
+ *
+ * @tparam BATCH records buffered per write
+ * @param capacity log capacity (records)
+ * @param appends number of records appended
+ */
+template <size_t BATCH>
+static void benchAppend(size_t capacity, uint32_t appends)
+{
+	EEPROM_RingLog<Sample, BATCH> log(capacity);
+	Sample sample = {0, {0, 0}};
+
+	EEPROM.resize(log.getSize());
+	log.begin(0);
+	EEPROM.resetCounters();
+
+	Clock::time_point start = Clock::now();
+	for (uint32_t i = 0; i < appends; i++)
+	{
+		sample.time = i;
+		sample.value[0] = i * 0.5f;
+		log.append(sample);
+	}
+	log.flush();
+	double ns = elapsedNs(start);
+
+	printf("%6u %9u %14.1f %14.2f %12.1f\n", (unsigned)BATCH, (unsigned)capacity, ns / appends, 1e3 * appends / ns,
+		   (double)EEPROM.getWrites() / appends);
+}
+
+/**
+ * @brief Time begin() on a log in one state
+ *
+ * @param capacity log capacity (records)
+ * @param written records written before the boot
+ * @param tornFirst damage slot 0, as a write interrupted by power loss would (written must exceed capacity)
+ * @param repeats number of begin() calls timed
+ */
+static void benchBegin(size_t capacity, uint32_t written, bool tornFirst, uint32_t repeats)
+{
+	EEPROM_RingLog<Sample, 1> writer(capacity);
+	Sample sample = {0, {0, 0}};
+	size_t slotSize = writer.getSize() / capacity;
+
+	EEPROM.resize(writer.getSize());
+	writer.begin(0);
+	for (uint32_t i = 0; i < written; i++)
+	{
+		sample.time = i;
+		writer.append(sample);
+	}
+	if (tornFirst)
+	{
+		EEPROM.data()[0] ^= 0x01;
+	}
+
+	// Expected state after the boot: a damaged slot 0 that is not the newest is still counted (readNext() skips it)
+	size_t count = min((size_t)written, capacity);
+	uint32_t next = written;
+
+	EEPROM_RingLog<Sample, 1> reader(capacity);
+	EEPROM.resetCounters();
+	Clock::time_point start = Clock::now();
+	for (uint32_t i = 0; i < repeats; i++)
+	{
+		reader.begin(0);
+	}
+	double ns = elapsedNs(start) / repeats;
+	double slotsRead = (double)EEPROM.getReads() / slotSize / repeats;
+
+	bool correct = (reader.getCount() == count) && (reader.getNextSequence() == next);
+	printf("%9u %9u %6s %12u %12.1f %12.1f %10.1f %8s\n", (unsigned)capacity, (unsigned)written, tornFirst ? "yes" : "no",
+		   (unsigned)((written == 0) ? 0 : (written - 1) % capacity), ns, slotsRead, 100.0 * slotsRead / capacity,
+		   correct ? "ok" : "WRONG");
+	if (!correct)
+	{
+		fprintf(stderr, "begin() found %u records, next sequence %lu; expected %u, %lu\n", (unsigned)reader.getCount(),
+				(unsigned long)reader.getNextSequence(), (unsigned)count, (unsigned long)next);
+		exit(1);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t appends = 1000000;
+	uint32_t repeats = 200;
+	int option;
+
+	while ((option = getopt(argc, argv, "n:r:")) != -1)
+	{
+		switch (option)
+		{
+		case 'n':
+			appends = strtoul(optarg, NULL, 0);
+			break;
+		case 'r':
+			repeats = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-n appends] [-r begin repeats]\n", argv[0]);
+			return 2;
+		}
+	}
+	if ((appends == 0) || (repeats == 0))
+	{
+		fprintf(stderr, "%s: -n and -r must be at least 1\n", argv[0]);
+		return 2;
+	}
+
+	printf("Append throughput, %u appends of %u-byte records\n\n", (unsigned)appends, (unsigned)sizeof(Sample));
+	printf("%6s %9s %14s %14s %12s\n", "batch", "capacity", "ns/append", "Mappends/s", "bytes/rec");
+	benchAppend<1>(256, appends);
+	benchAppend<4>(256, appends);
+	benchAppend<16>(256, appends);
+	benchAppend<4>(4096, appends);
+
+	printf("\nHead discovery (begin), %u repeats\n\n", (unsigned)repeats);
+	printf("%9s %9s %6s %12s %12s %12s %10s %8s\n", "capacity", "written", "torn", "newest slot", "ns/begin",
+		   "slots read", "% of scan", "result");
+	const size_t capacities[] = {16, 256, 4096};
+	for (size_t c = 0; c < sizeof(capacities) / sizeof(capacities[0]); c++)
+	{
+		size_t capacity = capacities[c];
+
+		benchBegin(capacity, 0, false, repeats);
+		benchBegin(capacity, capacity / 3, false, repeats);
+		benchBegin(capacity, capacity, false, repeats);
+		benchBegin(capacity, 2 * capacity + capacity / 2, false, repeats);
+		benchBegin(capacity, 3 * capacity - 1, false, repeats);
+		benchBegin(capacity, 2 * capacity + capacity / 2, true, repeats);
+	}
+	return 0;
+}
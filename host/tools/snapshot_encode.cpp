@@ -0,0 +1,213 @@
+/**
+ * @file snapshot_encode.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Fleet provisioning: UserSettingsClass snapshots for many devices from one CSV file
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include <unistd.h>
+#include <string>
+#include "EEPROM_Snapshot.h"
+#include "UserSettingsClass.h"
+
+/**
+ * @details
+ *
+ * Reads a CSV file (or standard input) with one device per row. The header row names the columns: "device"
+ * for the device name, and settings by member name as in USER_SETTINGS() (timeZone, dstOffset, dstEnabled,
+ * hostName, antennaType). Settings without a column, or with an empty cell, keep their defaults.
+ * Values are parsed and range-checked by the settings' field table (EEPROM_Fields::parse()), so booleans may
+ * be yes/no and the antenna type a display name such as "External".
+ *
+ * Each valid row is written as <directory>/<device>.snap, a snapshot ready for
+ * UserSettingsClass::importSnapshot(). Invalid rows are reported with their line and column and skipped, and
+ * the exit status is then 1. Cells cannot contain commas or quotes.
+ *
+ * Usage: snapshot_encode [-o directory] [file.csv]
+ */
+
+//! @brief Longest input line (bytes)
+static const size_t MAX_LINE = 1024;
+
+//! @brief Most columns in a row
+static const size_t MAX_COLUMNS = 32;
+
+/**
+ * @brief Split a CSV line in place
+ *
+ * @param line line, without its end of line
+ * @param cells receives the cells
+ * @return size_t number of cells
+ */
+static size_t splitLine(char *line, char **cells)
+{
+	size_t count = 0;
+
+	cells[count++] = line;
+	for (char *p = line; *p != 0; p++)
+	{
+		if ((*p == ',') && (count < MAX_COLUMNS))
+		{
+			*p = 0;
+			cells[count++] = p + 1;
+		}
+	}
+	return count;
+}
+
+/**
+ * @brief Remove the end of line and surrounding spaces
+ */
+static char *trim(char *text)
+{
+	char *end = text + strlen(text);
+
+	while ((*text == ' ') || (*text == '\t'))
+	{
+		text++;
+	}
+	while ((end > text) && ((end[-1] == '\n') || (end[-1] == '\r') || (end[-1] == ' ') || (end[-1] == '\t')))
+	{
+		*--end = 0;
+	}
+	return text;
+}
+
+static void usage(const char *program)
+{
+	fprintf(stderr, "usage: %s [-o directory] [file.csv]\n", program);
+	exit(2);
+}
+
+int main(int argc, char **argv)
+{
+	const char *directory = ".";
+	int option;
+
+	while ((option = getopt(argc, argv, "o:")) != -1)
+	{
+		switch (option)
+		{
+		case 'o':
+			directory = optarg;
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+	if (argc - optind > 1)
+	{
+		usage(argv[0]);
+	}
+
+	FILE *input = (optind < argc) ? fopen(argv[optind], "r") : stdin;
+	if (input == NULL)
+	{
+		perror(argv[optind]);
+		return 2;
+	}
+
+	char header[MAX_LINE];
+	char *names[MAX_COLUMNS];
+	const EEPROM_Field *columns[MAX_COLUMNS];
+	size_t columnCount;
+	size_t deviceColumn = MAX_COLUMNS;
+
+	if (fgets(header, sizeof(header), input) == NULL)
+	{
+		fprintf(stderr, "%s: no header row\n", argv[0]);
+		return 2;
+	}
+	columnCount = splitLine(trim(header), names);
+	for (size_t c = 0; c < columnCount; c++)
+	{
+		names[c] = trim(names[c]);
+		columns[c] = NULL;
+		if (strcmp(names[c], "device") == 0)
+		{
+			deviceColumn = c;
+			continue;
+		}
+		for (size_t f = 0; f < UserSettingsClass::fieldCount; f++)
+		{
+			if (strcmp(names[c], UserSettingsClass::fields[f].name) == 0)
+			{
+				columns[c] = &UserSettingsClass::fields[f];
+			}
+		}
+		if (columns[c] == NULL)
+		{
+			fprintf(stderr, "%s: unknown column \"%s\"\n", argv[0], names[c]);
+			return 2;
+		}
+	}
+	if (deviceColumn == MAX_COLUMNS)
+	{
+		fprintf(stderr, "%s: no \"device\" column\n", argv[0]);
+		return 2;
+	}
+
+	char line[MAX_LINE];
+	unsigned lineNumber = 1;
+	unsigned written = 0;
+	unsigned rejected = 0;
+
+	while (fgets(line, sizeof(line), input) != NULL)
+	{
+		char *cells[MAX_COLUMNS];
+		size_t cellCount;
+		SettingsObject settings = UserSettingsClass::defaultSettings;
+		const char *device;
+		bool valid = true;
+
+		lineNumber++;
+		if (*trim(line) == 0)
+		{
+			continue;
+		}
+		cellCount = splitLine(trim(line), cells);
+		device = (deviceColumn < cellCount) ? trim(cells[deviceColumn]) : "";
+		if ((*device == 0) || (strchr(device, '/') != NULL))
+		{
+			fprintf(stderr, "line %u: invalid device name\n", lineNumber);
+			rejected++;
+			continue;
+		}
+
+		for (size_t c = 0; (c < cellCount) && (c < columnCount); c++)
+		{
+			char *cell = trim(cells[c]);
+
+			if ((columns[c] != NULL) && (*cell != 0) && !EEPROM_Fields::parse(*columns[c], cell, &settings))
+			{
+				fprintf(stderr, "line %u (%s): invalid %s \"%s\"\n", lineNumber, device, names[c], cell);
+				valid = false;
+			}
+		}
+		if (!valid)
+		{
+			rejected++;
+			continue;
+		}
+
+		uint8_t snapshot[UserSettingsClass::SNAPSHOT_SIZE];
+		size_t length = EEPROM_Snapshot::encode(&settings, sizeof(settings), EEPROM_Snapshot::typeTag<SettingsObject>(),
+												snapshot, sizeof(snapshot));
+		std::string path = std::string(directory) + "/" + device + ".snap";
+		FILE *output = fopen(path.c_str(), "wb");
+
+		if ((output == NULL) || (fwrite(snapshot, 1, length, output) != length) || (fclose(output) != 0))
+		{
+			perror(path.c_str());
+			return 2;
+		}
+		written++;
+	}
+
+	printf("%u snapshots written to %s, %u rows rejected\n", written, directory, rejected);
+	return (rejected != 0) ? 1 : 0;
+}
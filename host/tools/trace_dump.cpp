@@ -0,0 +1,72 @@
+/**
+ * @file trace_dump.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Binary EEPROM trace to Chrome trace_event JSON
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#include <Particle.h>
+#include <vector>
+#include "EEPROM_TraceFormat.h"
+
+/**
+ * @details
+ *
+ * Reads a binary trace (EEPROM_Trace::exportBinary(), e.g. uploaded from a device in the field) from a file or
+ * standard input, validates it and prints its spans, oldest first, as the Chrome trace_event JSON that
+ * EEPROM_Trace::dump() prints on the device, for chrome://tracing or Perfetto. Exits 1 if the trace is invalid.
+ *
+ * Usage: trace_dump [file]
+ */
+
+int main(int argc, char **argv)
+{
+	if (argc > 2)
+	{
+		fprintf(stderr, "usage: %s [file]\n", argv[0]);
+		return 2;
+	}
+
+	FILE *input = (argc == 2) ? fopen(argv[1], "rb") : stdin;
+	if (input == NULL)
+	{
+		perror(argv[1]);
+		return 2;
+	}
+
+	std::vector<uint8_t> trace;
+	uint8_t block[4096];
+	size_t read;
+
+	while ((read = fread(block, 1, sizeof(block), input)) > 0)
+	{
+		trace.insert(trace.end(), block, block + read);
+	}
+	if (input != stdin)
+	{
+		fclose(input);
+	}
+
+	int count = trace.empty() ? -1 : EEPROM_TraceFormat::decodeHeader(&trace[0], trace.size());
+	if (count < 0)
+	{
+		fprintf(stderr, "%s: invalid trace\n", argv[0]);
+		return 1;
+	}
+
+	printf("{\"traceEvents\":[");
+	for (int i = 0; i < count; i++)
+	{
+		EEPROM_TraceEvent event;
+		char text[EEPROM_TraceFormat::JSON_SIZE];
+
+		EEPROM_TraceFormat::decodeRecord(&trace[EEPROM_TraceFormat::HEADER_SIZE + i * EEPROM_TraceFormat::RECORD_SIZE], event);
+		EEPROM_TraceFormat::formatJson(event, text, sizeof(text));
+		printf("%s%s", (i == 0) ? "" : ",\n", text);
+	}
+	printf("]}\n");
+	return 0;
+}
@@ -0,0 +1,214 @@
+/**
+ * @file EEPROM_BootLoader.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief EEPROM Bulk Boot Loader Class Member Functions
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+
+#include <Particle.h>
+#include "EEPROM_BootLoader.h"
+#include "EEPROM_Fault.h"
+
+void EEPROM_BootLoader::add(EEPROM_Object &member)
+{
+	EEPROM_Object **link = &_first;
+
+	// Keep the list in address order, so that reads and default writes are sequential
+	while ((*link != NULL) && ((*link)->getAddress() < member.getAddress()))
+	{
+		link = &(*link)->_nextBoot;
+	}
+	member._nextBoot = *link;
+	*link = &member;
+}
+
+bool EEPROM_BootLoader::load(uint8_t *buffer, size_t length)
+{
+	uint32_t bootStart = micros();
+	EEPROM_Object *window = _first;
+	bool flag = true;
+
+	while (window != NULL)
+	{
+		uint16_t start = window->getAddress();
+		EEPROM_Object *next = _nextWindow(window, length);
+
+		if (next == window)
+		{
+			// Too large for the buffer: loaded on its own
+			uint32_t memberStart = micros();
+
+			Log.warn("EEPROM object at %d larger than boot buffer, loaded directly.", start);
+			window->_bootValid = window->loadDirect();
+			window->_bootMicros = micros() - memberStart;
+			flag = flag && window->_bootValid;
+			window = window->_nextBoot;
+			continue;
+		}
+		size_t end = _windowEnd(window, next);
+
+		// One sequential read of the window
+		uint32_t readStart = micros();
+		HAL_EEPROM_Get(start, buffer, end - start);
+		uint32_t readMicros = micros() - readStart;
+
+		for (EEPROM_Object *member = window; member != next; member = member->_nextBoot)
+		{
+			uint32_t memberStart = micros();
+			member->_bootValid = member->loadImage(&buffer[member->getAddress() - start]);
+
+			// Share of the bulk read, by size
+			member->_bootMicros = (micros() - memberStart) + (uint32_t)((uint64_t)readMicros * member->getSize() / (end - start));
+			flag = flag && member->_bootValid;
+		}
+		window = next;
+	}
+
+	if (!flag)
+	{
+		_writeDefaults(buffer, length);
+	}
+
+	_bootMicros = micros() - bootStart;
+	Log.trace("EEPROM boot load: %lu us", (unsigned long)_bootMicros);
+	return flag;
+}
+
+void EEPROM_BootLoader::_writeDefaults(uint8_t *buffer, size_t length)
+{
+	EEPROM_Object *window = _first;
+
+	while (window != NULL)
+	{
+		uint16_t start = window->getAddress();
+		EEPROM_Object *next = _nextWindow(window, length);
+		size_t runStart = 0;
+		size_t runEnd = 0;
+		uint32_t writeMicros = 0;
+		size_t batchedSize = 0;
+
+		if (next == window)
+		{
+			// Too large for the buffer: writes its own defaults
+			if (!window->_bootValid)
+			{
+				_loadDefaults(*window);
+			}
+			window = window->_nextBoot;
+			continue;
+		}
+
+		// Build the images of the window's invalid objects in the buffer, writing each contiguous run at once
+		for (EEPROM_Object *member = window; member != next; member = member->_nextBoot)
+		{
+			uint32_t memberStart = micros();
+			size_t offset = 0;
+			size_t imageEnd;
+
+			member->_bootBatched = false;
+			if (member->_bootValid)
+			{
+				continue;
+			}
+
+			imageEnd = member->buildDefaults(&buffer[member->getAddress() - start], offset);
+			if (imageEnd == 0)
+			{
+				// Not batched (no defaults, in a commit group or held by the wear budget)
+				writeMicros += _writeRun(buffer, start, runStart, runEnd);
+				runStart = runEnd;
+				_loadDefaults(*member);
+				continue;
+			}
+			if ((member->getAddress() + offset) != runEnd)
+			{
+				writeMicros += _writeRun(buffer, start, runStart, runEnd);
+				runStart = member->getAddress() + offset;
+			}
+			runEnd = member->getAddress() + imageEnd;
+			member->_bootBatched = true;
+			member->_bootMicros += micros() - memberStart;
+			batchedSize += member->getSize();
+			Log.warn("EEPROM object at %d invalid, reset to defaults.", member->getAddress());
+		}
+		writeMicros += _writeRun(buffer, start, runStart, runEnd);
+
+		// Checksums last, so that a batch cut by power loss leaves no image valid
+		for (EEPROM_Object *member = window; member != next; member = member->_nextBoot)
+		{
+			if (member->_bootBatched)
+			{
+				uint32_t memberStart = micros();
+
+				member->sealDefaults();
+
+				// Share of the batched write, by size
+				member->_bootMicros += (micros() - memberStart) + (uint32_t)((uint64_t)writeMicros * member->getSize() / batchedSize);
+			}
+		}
+		window = next;
+	}
+}
+
+uint32_t EEPROM_BootLoader::_writeRun(const uint8_t *buffer, uint16_t start, size_t runStart, size_t runEnd)
+{
+	uint32_t writeStart = micros();
+
+	if (runEnd > runStart)
+	{
+		EEPROM_PUT_BLOCK(runStart, &buffer[runStart - start], runEnd - runStart);
+	}
+	return micros() - writeStart;
+}
+
+void EEPROM_BootLoader::_loadDefaults(EEPROM_Object &member)
+{
+	uint32_t memberStart = micros();
+
+	if (member.loadDefaults())
+	{
+		Log.warn("EEPROM object at %d invalid, reset to defaults.", member.getAddress());
+	}
+	else
+	{
+		Log.error("EEPROM object at %d invalid, no defaults.", member.getAddress());
+	}
+	member._bootMicros += micros() - memberStart;
+}
+
+EEPROM_Object *EEPROM_BootLoader::_nextWindow(EEPROM_Object *window, size_t length)
+{
+	EEPROM_Object *next = window;
+
+	// As many whole objects as fit in the buffer; none if the first is larger than the buffer
+	while ((next != NULL) && ((next->getAddress() + next->getSize() - window->getAddress()) <= length))
+	{
+		next = next->_nextBoot;
+	}
+	return next;
+}
+
+size_t EEPROM_BootLoader::_windowEnd(EEPROM_Object *window, EEPROM_Object *next)
+{
+	size_t end = window->getAddress();
+
+	for (EEPROM_Object *member = window; member != next; member = member->_nextBoot)
+	{
+		end = max(end, (size_t)(member->getAddress() + member->getSize()));
+	}
+	return end;
+}
+
+void EEPROM_BootLoader::report(Print &out)
+{
+	for (EEPROM_Object *member = _first; member != NULL; member = member->_nextBoot)
+	{
+		out.printlnf("{\"op\":\"boot\",\"address\":%u,\"size\":%u,\"valid\":%s,\"us\":%lu}", member->getAddress(), (unsigned)member->getSize(),
+					 member->_bootValid ? "true" : "false", (unsigned long)member->getBootMicros());
+	}
+	out.printlnf("{\"op\":\"bootTotal\",\"us\":%lu}", (unsigned long)_bootMicros);
+}
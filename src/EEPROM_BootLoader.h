@@ -0,0 +1,131 @@
+/**
+ * @file EEPROM_BootLoader.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief EEPROM Bulk Boot Loader Class Header
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#pragma once
+#include <Particle.h>
+#include "EEPROM_Object.h"
+
+/**
+ * @brief EEPROM Boot Loader
+ * 
+ * Loads every registered EEPROM_Class instance (of any object type, including UserSettingsClass) at startup
+ * with one sequential bulk read of the EEPROM range they occupy, instead of a separate scattered read and
+ * checksum pass per object. Each object's image is verified and loaded from the RAM copy. Objects with
+ * invalid images are then reset to their defaults (UserSettingsClass defaults, or those given to
+ * EEPROM_Class::setDefaults()): their images are built in the buffer and written in one sequential write per
+ * contiguous run of objects, with the checksums written after the whole batch.
+ * 
+ * The bulk read uses a caller-supplied buffer. If the used range does not fit, it is read in as few windows
+ * as possible, each holding whole objects. An object larger than the buffer is loaded, and if need be reset
+ * to its defaults, on its own.
+ * 
+ * The time spent on each object, including its share of the bulk read, is available from
+ * EEPROM_Object::getBootMicros().
+ * 
+ * @code
+ *     uint8_t buffer[256];
+ *     EEPROM_BootLoader myLoader;
+ *     mySettings.attach(objectAddress);
+ *     myLoader.add(mySettings);
+ *     myEEPROM.attach(objectAddress + mySettings.getSize(), myCredentials);
+ *     myLoader.add(myEEPROM);
+ *     myLoader.load(buffer, sizeof(buffer));
+ * @endcode
+ */
+class EEPROM_BootLoader
+{
+public:
+	/**
+	 * @brief Construct a new boot loader object
+	 * 
+	 */
+	EEPROM_BootLoader()
+	{
+		Log.trace("in EEPROM_BootLoader Constructor.");
+	}
+
+	/**
+	 * @brief Register an object. Its address must already be assigned with attach().
+	 * 
+	 * @param member object to register
+	 */
+	void add(EEPROM_Object &member);
+
+	/**
+	 * @brief Load all registered objects, resetting invalid objects to their defaults
+	 * 
+	 * Defaults of an object in a commit group are held until the group is committed, and defaults refused by
+	 * an object's wear budget are held as for any other write.
+	 * 
+	 * @param buffer Work buffer for the bulk read and the batched defaults write
+	 * @param length Size of the work buffer; ideally at least the size of the largest object
+	 * @return true All objects loaded from EEPROM
+	 * @return false One or more objects invalid (reset to defaults where available)
+	 */
+	bool load(uint8_t *buffer, size_t length);
+
+	/**
+	 * @brief Print the load time and result of each object as a JSON line
+	 * 
+	 * @param out Output stream, e.g. Serial
+	 */
+	void report(Print &out);
+
+	/**
+	 * @brief Get the total time of the last load()
+	 * 
+	 * @return uint32_t microseconds
+	 */
+	uint32_t getBootMicros() { return _bootMicros; }
+
+private:
+	/** @brief First registered object, lowest address
+	 */
+	EEPROM_Object *_first = NULL;
+
+	/** @brief Total time of the last load (microseconds)
+	 */
+	uint32_t _bootMicros = 0;
+
+	/**
+	 * @brief Reset the invalid objects to their defaults, batching the writes in the buffer
+	 */
+	void _writeDefaults(uint8_t *buffer, size_t length);
+
+	/**
+	 * @brief Write a run of default images from the buffer
+	 * 
+	 * @param buffer Buffer holding the window starting at start
+	 * @param start EEPROM address of the window
+	 * @param runStart EEPROM address of the run
+	 * @param runEnd EEPROM address of the end of the run, runStart for an empty run
+	 * @return uint32_t microseconds taken
+	 */
+	static uint32_t _writeRun(const uint8_t *buffer, uint16_t start, size_t runStart, size_t runEnd);
+
+	/**
+	 * @brief Reset one object to its defaults with its own write
+	 */
+	static void _loadDefaults(EEPROM_Object &member);
+
+	/**
+	 * @brief Find the end of a window of whole objects that fit in the buffer
+	 * 
+	 * @param window First object of the window
+	 * @param length Size of the buffer
+	 * @return EEPROM_Object* first object after the window; window itself if it is larger than the buffer
+	 */
+	static EEPROM_Object *_nextWindow(EEPROM_Object *window, size_t length);
+
+	/**
+	 * @brief Get the end address of a window
+	 */
+	static size_t _windowEnd(EEPROM_Object *window, EEPROM_Object *next);
+};
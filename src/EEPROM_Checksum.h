@@ -0,0 +1,90 @@
+/**
+ * @file EEPROM_Checksum.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief EEPROM Image Checksum
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief EEPROM Checksum
+ * 
+ * The 16-bit additive checksum used by EEPROM_Class: the sum of all bytes of the object image, modulo 2^16,
+ * passed through seal() so that it is never TORN.
+ * 
+ * EEPROM_Class writes TORN to the checksum before it rewrites an image, and the sealed checksum after. An
+ * image cut by power loss therefore never passes, even where the additive sum of its mix of old and new
+ * bytes happens to equal the old checksum.
+ * 
+ * This header has no Particle dependencies so that host tools (e.g. for validating EEPROM dumps pulled
+ * from devices) can use the exact same calculation. An EEPROM_Class image in a dump is laid out as:
+ * 	- uint16_t checksum (little endian) at the object address.
+ * 	- The object, sizeof(OBJ) bytes.
+ * 	- Padding to the LAYOUT record size (none with the default layout).
+ * 
+ * The byte sum is computed four bytes at a time: each 32-bit word is split into two 16-bit lanes holding
+ * the sums of its even and odd bytes, and the lanes are folded together at the end.
+ */
+struct EEPROM_Checksum
+{
+	/**
+	 * @brief Calculate the checksum of a RAM buffer
+	 * 
+	 * @param data Buffer
+	 * @param length Number of bytes
+	 * @param seed Checksum of any preceding data, to continue a checksum over several buffers
+	 * @return uint16_t calculated checksum (not sealed)
+	 */
+	static uint16_t calculate(const void *data, size_t length, uint16_t seed = 0)
+	{
+		const uint8_t *bytes = static_cast<const uint8_t *>(data);
+		uint32_t temp = seed;
+
+		while (length >= sizeof(uint32_t))
+		{
+			// Each lane gains at most 2 x 255 per word, so fold every 128 words before it can overflow
+			size_t words = length / sizeof(uint32_t);
+			uint32_t lanes = 0;
+
+			if (words > 128)
+			{
+				words = 128;
+			}
+
+			for (size_t i = 0; i < words; i++)
+			{
+				uint32_t word;
+				memcpy(&word, bytes, sizeof(word));
+				lanes += (word & 0x00FF00FF) + ((word >> 8) & 0x00FF00FF);
+				bytes += sizeof(word);
+			}
+			temp += (lanes & 0xFFFF) + (lanes >> 16);
+			length -= words * sizeof(uint32_t);
+		}
+
+		while (length-- > 0)
+		{
+			temp += *bytes++;
+		}
+		return (uint16_t)temp;
+	}
+
+	/** @brief Stored in place of the checksum while an image is rewritten; never a valid checksum
+	 */
+	static const uint16_t TORN = 0xFFFF;
+
+	/**
+	 * @brief Make a checksum storable: the (rare) sum TORN is stored as 0
+	 * 
+	 * @param sum Checksum from calculate()
+	 * @return uint16_t checksum to store and compare
+	 */
+	static uint16_t seal(uint16_t sum) { return (sum == TORN) ? 0 : sum; }
+};
@@ -0,0 +1,156 @@
+/**
+ * @file EEPROM_Cipher.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Cipher and MAC Primitives for Encrypted EEPROM Objects
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+
+#include "EEPROM_Cipher.h"
+
+static inline uint32_t rotl32(uint32_t x, int n)
+{
+	return (x << n) | (x >> (32 - n));
+}
+
+static inline uint64_t rotl64(uint64_t x, int n)
+{
+	return (x << n) | (x >> (64 - n));
+}
+
+static inline uint32_t load32(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint64_t load64(const uint8_t *p)
+{
+	return load32(p) | ((uint64_t)load32(p + 4) << 32);
+}
+
+#define QUARTER_ROUND(a, b, c, d) \
+	a += b;                       \
+	d = rotl32(d ^ a, 16);        \
+	c += d;                       \
+	b = rotl32(b ^ c, 12);        \
+	a += b;                       \
+	d = rotl32(d ^ a, 8);         \
+	c += d;                       \
+	b = rotl32(b ^ c, 7);
+
+void EEPROM_Cipher::chacha20(const uint8_t *key, const uint8_t *nonce, uint32_t counter, uint8_t *data, size_t length)
+{
+	uint32_t input[16];
+
+	input[0] = 0x61707865;
+	input[1] = 0x3320646e;
+	input[2] = 0x79622d32;
+	input[3] = 0x6b206574;
+	for (int i = 0; i < 8; i++)
+	{
+		input[4 + i] = load32(&key[i * 4]);
+	}
+	input[12] = counter;
+	for (int i = 0; i < 3; i++)
+	{
+		input[13 + i] = load32(&nonce[i * 4]);
+	}
+
+	while (length > 0)
+	{
+		uint32_t x[16];
+
+		for (int i = 0; i < 16; i++)
+		{
+			x[i] = input[i];
+		}
+		for (int i = 0; i < 10; i++)
+		{
+			QUARTER_ROUND(x[0], x[4], x[8], x[12]);
+			QUARTER_ROUND(x[1], x[5], x[9], x[13]);
+			QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+			QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+			QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+			QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+			QUARTER_ROUND(x[2], x[7], x[8], x[13]);
+			QUARTER_ROUND(x[3], x[4], x[9], x[14]);
+		}
+
+		// XOR the keystream block into the data
+		for (int i = 0; (i < 64) && (length > 0); i++, length--)
+		{
+			*data++ ^= (uint8_t)((x[i / 4] + input[i / 4]) >> (8 * (i % 4)));
+		}
+		input[12]++;
+	}
+}
+
+#define SIP_ROUND(v0, v1, v2, v3) \
+	v0 += v1;                     \
+	v1 = rotl64(v1, 13);          \
+	v1 ^= v0;                     \
+	v0 = rotl64(v0, 32);          \
+	v2 += v3;                     \
+	v3 = rotl64(v3, 16);          \
+	v3 ^= v2;                     \
+	v0 += v3;                     \
+	v3 = rotl64(v3, 21);          \
+	v3 ^= v0;                     \
+	v2 += v1;                     \
+	v1 = rotl64(v1, 17);          \
+	v1 ^= v2;                     \
+	v2 = rotl64(v2, 32);
+
+uint64_t EEPROM_Cipher::siphash(const uint8_t *key, const uint8_t *data, size_t length)
+{
+	uint64_t k0 = load64(key);
+	uint64_t k1 = load64(key + 8);
+	uint64_t v0 = k0 ^ 0x736f6d6570736575ULL;
+	uint64_t v1 = k1 ^ 0x646f72616e646f6dULL;
+	uint64_t v2 = k0 ^ 0x6c7967656e657261ULL;
+	uint64_t v3 = k1 ^ 0x7465646279746573ULL;
+	uint64_t last = (uint64_t)length << 56;
+	size_t i = 0;
+
+	for (; i + 8 <= length; i += 8)
+	{
+		uint64_t m = load64(&data[i]);
+
+		v3 ^= m;
+		SIP_ROUND(v0, v1, v2, v3);
+		SIP_ROUND(v0, v1, v2, v3);
+		v0 ^= m;
+	}
+	for (int shift = 0; i < length; i++, shift += 8)
+	{
+		last |= (uint64_t)data[i] << shift;
+	}
+
+	v3 ^= last;
+	SIP_ROUND(v0, v1, v2, v3);
+	SIP_ROUND(v0, v1, v2, v3);
+	v0 ^= last;
+
+	v2 ^= 0xFF;
+	SIP_ROUND(v0, v1, v2, v3);
+	SIP_ROUND(v0, v1, v2, v3);
+	SIP_ROUND(v0, v1, v2, v3);
+	SIP_ROUND(v0, v1, v2, v3);
+	return v0 ^ v1 ^ v2 ^ v3;
+}
+
+bool EEPROM_Cipher::equal(const void *a, const void *b, size_t length)
+{
+	const volatile uint8_t *x = static_cast<const volatile uint8_t *>(a);
+	const volatile uint8_t *y = static_cast<const volatile uint8_t *>(b);
+	uint8_t difference = 0;
+
+	for (size_t i = 0; i < length; i++)
+	{
+		difference |= x[i] ^ y[i];
+	}
+	return difference == 0;
+}
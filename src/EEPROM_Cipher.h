@@ -0,0 +1,69 @@
+/**
+ * @file EEPROM_Cipher.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Cipher and MAC Primitives for Encrypted EEPROM Objects
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Cipher and MAC primitives used by EEPROM_SecureClass
+ * 
+ * 	- ChaCha20 stream cipher (RFC 7539), 256-bit key, 96-bit nonce.
+ * 	- SipHash-2-4 keyed hash, 128-bit key, 64-bit tag.
+ * 
+ * Both are small, table-free and constant-time on Cortex-M, and need no hardware support.
+ * This header has no Particle dependencies, so host tools can encrypt or verify EEPROM images.
+ */
+struct EEPROM_Cipher
+{
+	//! @brief ChaCha20 key size (bytes)
+	static const size_t KEY_SIZE = 32;
+
+	//! @brief ChaCha20 nonce size (bytes)
+	static const size_t NONCE_SIZE = 12;
+
+	//! @brief SipHash key size (bytes)
+	static const size_t MAC_KEY_SIZE = 16;
+
+	/**
+	 * @brief Encrypt or decrypt in place with ChaCha20
+	 * 
+	 * @param key Key, KEY_SIZE bytes
+	 * @param nonce Nonce, NONCE_SIZE bytes; must never repeat for the same key
+	 * @param counter Initial block counter
+	 * @param data Data
+	 * @param length Number of bytes
+	 */
+	static void chacha20(const uint8_t *key, const uint8_t *nonce, uint32_t counter, uint8_t *data, size_t length);
+
+	/**
+	 * @brief Calculate a SipHash-2-4 tag
+	 * 
+	 * @param key Key, MAC_KEY_SIZE bytes
+	 * @param data Data
+	 * @param length Number of bytes
+	 * @return uint64_t tag
+	 */
+	static uint64_t siphash(const uint8_t *key, const uint8_t *data, size_t length);
+
+	/**
+	 * @brief Compare two buffers in constant time, for tag checks
+	 * 
+	 * Every byte is compared whatever the contents, so the time taken does not reveal how much of a forged tag
+	 * was correct.
+	 * 
+	 * @param a First buffer
+	 * @param b Second buffer
+	 * @param length Number of bytes
+	 * @return true Buffers equal
+	 * @return false Buffers differ
+	 */
+	static bool equal(const void *a, const void *b, size_t length);
+};
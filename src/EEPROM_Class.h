@@ -12,10 +12,35 @@
  * |         | 2019-09-15 | Removed user name and password items |
  * --------------------------------------------------------------------------------
  * | 1.0.2   | 2019-09-17 | added getSize() member function to return object size |
+ * --------------------------------------------------------------------------------
+ * | 1.2.0   | 2026-10-18 | added layout policy and write counters |
+ * |         | 2026-10-18 | added commit group support |
+ * |         | 2026-10-18 | added wear budget write throttling |
+ * |         | 2026-10-18 | checksum computed in blocks via EEPROM_Checksum |
+ * |         | 2026-10-18 | added bytes read counter |
+ * |         | 2026-10-18 | added trace hooks (EEPROM_TRACE) |
+ * |         | 2026-10-18 | verifyChecksum() cached per write generation, added scrub() |
+ * |         | 2026-10-18 | added sparse defaults overlay mode (setDefaults()) |
+ * |         | 2026-10-18 | added snapshot export/import |
+ * |         | 2026-10-18 | writes routed through EEPROM_Fault (EEPROM_FAULT_INJECTION) |
+ * |         | 2026-10-18 | added attach()/loadImage() for EEPROM_BootLoader |
+ * |         | 2026-10-18 | unaligned addresses rounded up to the LAYOUT record boundary |
+ * |         | 2026-10-18 | snapshots type-tagged and validated; import respects wear budget |
+ * |         | 2026-10-18 | checksum set to TORN during a write: power-cut images never pass |
+ * |         | 2026-10-18 | added loadDirect() and batched defaults images for EEPROM_BootLoader |
+ * |         | 2026-10-18 | snapshot type tags declared with EEPROM_SNAPSHOT_TAG() |
+ * |         | 2026-10-18 | flush() for held updates, getLifetimeWrites() to persist the count |
  * 
  */
 #pragma once
 #include <Particle.h>
+#include "EEPROM_Checksum.h"
+#include "EEPROM_Snapshot.h"
+#include "EEPROM_Trace.h"
+#include "EEPROM_Fault.h"
+#include "EEPROM_Layout.h"
+#include "EEPROM_Object.h"
+#include "EEPROM_WearBudget.h"
 
 /**
  * @brief EEPROM Class
@@ -31,10 +56,32 @@
  * via EEPROM.put(), and a new checksum is calculated and stored as well.
  * 
  * The class is intended to be used as the base class for deriving more data-specific classes.
+ * 
+ * The optional LAYOUT policy (see EEPROM_Layout.h) aligns and sizes the image to the record geometry
+ * of flash-emulated EEPROM. Write counters are maintained to monitor compaction pressure.
+ * 
+ * Instances may join an EEPROM_CommitGroup, in which case writes are deferred and committed together
+ * with the other members of the group.
+ * 
+ * An optional wear budget limits the write rate. Updates beyond the budget are held in RAM and
+ * coalesced into the next allowed write (see setWearBudget() and process()). A held update is lost on
+ * reset unless written first with flush().
+ * 
+ * verifyChecksum() caches its result until the next write. scrub() re-reads the image from EEPROM
+ * incrementally, to detect media corruption without stalling the caller.
+ * 
+ * In overlay mode (see setDefaults()) the defaults are held in flash and EEPROM stores only a bitmap and
+ * the parts of the object that differ from the defaults. The image then consists of:
+ * 	- Checksum.
+ * 	- Bitmap, one bit per OVERLAY_CHUNK bytes of the object, set if the chunk differs from the defaults.
+ * 	- The differing chunks, packed in order.
+ * 
+ * @tparam OBJ Data object type
+ * @tparam LAYOUT Image layout policy
  */
 
-template <class OBJ>
-class EEPROM_Class
+template <class OBJ, class LAYOUT = EEPROM_DefaultLayout>
+class EEPROM_Class : public EEPROM_Object
 {
 public:
 	/**
@@ -53,6 +100,10 @@ public:
 	~EEPROM_Class()
 	{
 		Log.trace("in EEPROM_Class Destructor.");
+		if (_pending && (_group == NULL))
+		{
+			Log.warn("EEPROM write held by the wear budget discarded.");
+		}
 	}
 
 	// EEPROM_Class(uint16_t address, OBJ &object)
@@ -64,6 +115,36 @@ public:
 	// 	Log.trace("_adr_checksum = %d, _adr_object = %d, _eepromSize = %d", _adr_checksum, _adr_object, _eepromSize);
 	// }
 
+	/** @brief Overlay mode chunk size (bytes)
+	 */
+	static const size_t OVERLAY_CHUNK = 4;
+
+	/** @brief Number of overlay chunks in the object
+	 */
+	static const size_t OVERLAY_CHUNKS = (sizeof(OBJ) + OVERLAY_CHUNK - 1) / OVERLAY_CHUNK;
+
+	/** @brief Size of the overlay bitmap (bytes)
+	 */
+	static const size_t OVERLAY_BITMAP = (OVERLAY_CHUNKS + 7) / 8;
+
+	/** @brief Writes of the checksum cells per commit (torn guard, then the checksum): the hottest cells of the image
+	 */
+	static const uint8_t CHECKSUM_WRITES = 2;
+
+	/**
+	 * @brief Select overlay mode: store only the differences from a set of defaults
+	 * 
+	 * Must be called before begin(). The defaults must remain valid for the life of the instance; a const
+	 * object at file or class scope is placed in flash. An image written in overlay mode cannot be read
+	 * in normal mode, and vice versa.
+	 * 
+	 * @param defaults Default values of the object
+	 */
+	void setDefaults(const OBJ &defaults)
+	{
+		_defaults = &defaults;
+	}
+
 	/**
 	 * @brief Initialize the object and load data from EEPROM
 	 * 
@@ -74,26 +155,306 @@ public:
 	 */
 	bool begin(uint16_t address, OBJ &object)
 	{
-		_adr_checksum = address;
-		_adr_object = _adr_checksum + sizeof(_checksum);
-		_eepromSize = sizeof(object) + sizeof(_checksum);
+		EEPROM_TRACE_SPAN(TRACE_BEGIN, address, sizeof(OBJ));
+		_setAddress(address);
+		return readObject(object);
+	}
+
+	/**
+	 * @brief Assign the address and data object without reading EEPROM, for loading by EEPROM_BootLoader
+	 * 
+	 * @param address: EEPROM relative address for the saved object
+	 * @param object: reference to the data object 
+	 */
+	void attach(uint16_t address, OBJ &object)
+	{
+		_object = &object;
+		_assignAddress(address);
+	}
+
+	/**
+	 * @brief Get the EEPROM address of the object, as given to begin() or attach()
+	 * 
+	 * The image starts here, or at the next LAYOUT record boundary if this address is not on one.
+	 * 
+	 * @return uint16_t address
+	 */
+	uint16_t getAddress() { return _adr_base; }
+
+	/**
+	 * @brief Get the working copy last attached by begin(), attach(), readObject() or writeObject()
+	 * 
+	 * @return OBJ* working copy, NULL if none
+	 */
+	OBJ *getObject() { return _object; }
+
+	/**
+	 * @brief Verify the image from a RAM copy of EEPROM and load the attached object from it
+	 * 
+	 * @param image Copy of the getSize() bytes of EEPROM at getAddress()
+	 * @return true Object loaded
+	 * @return false Image invalid, object not loaded
+	 */
+	bool loadImage(const uint8_t *image)
+	{
+		EEPROM_TRACE_SPAN(TRACE_READ, _adr_object, sizeof(OBJ));
+		const uint8_t *data = image + (_adr_object - _adr_base);
+
+		// The image was read from EEPROM by the caller: count it here
+		_bytesRead += _eepromSize;
+		memcpy(&_checksum, image + (_adr_checksum - _adr_base), sizeof(_checksum));
+		_generation++;
+		_verifiedGeneration = _generation;
+		_verifiedValid = false;
+
+		if ((_defaults != NULL) && !_overlayLength(data))
+		{
+			Log.error("EEPROM overlay bitmap invalid.");
+			return false;
+		}
+		if (_checksum != EEPROM_Checksum::seal(EEPROM_Checksum::calculate(data, _imageLength)))
+		{
+			Log.error("EEPROM object image invalid.");
+			return false;
+		}
+		_verifiedValid = true;
+
+		if (_defaults != NULL)
+		{
+			_mergeOverlay(data, *_object);
+		}
+		else
+		{
+			memcpy(_object, data, sizeof(OBJ));
+		}
+		Log.trace("EEPROM object image Loaded.");
+		return true;
+	}
+
+	/**
+	 * @brief Verify the image and load the attached object directly from EEPROM, e.g. when it is too large for
+	 * the boot loader's buffer
+	 * 
+	 * @return true Object loaded
+	 * @return false Image invalid or no object attached, object not loaded
+	 */
+	bool loadDirect()
+	{
+		if (_object == NULL)
+		{
+			return false;
+		}
 		EEPROM.get(_adr_checksum, _checksum);
-		Log.trace("_adr_checksum: %d, _adr_object: %d, _eepromSize: %d, checksum: 0x%04X", _adr_checksum, _adr_object, _eepromSize, _checksum);
+		_bytesRead += sizeof(_checksum);
+		return readObject(*_object);
+	}
 
-		return readObject(object);
+	/**
+	 * @brief Reset the attached object to its defaults and build its image in RAM, for a batched write
+	 * 
+	 * The image's checksum is EEPROM_Checksum::TORN until sealDefaults() is called. The write is counted here
+	 * and charged to the wear budget.
+	 * 
+	 * @param image Buffer for the getSize() bytes of EEPROM at getAddress(); only the image bytes are set
+	 * @param offset Set to the offset in the buffer of the checksum, the first image byte
+	 * @return size_t Offset in the buffer of the end of the image, 0 if not built (no defaults, in a commit
+	 * group or held by the wear budget)
+	 */
+	size_t buildDefaults(uint8_t *image, size_t &offset)
+	{
+		const OBJ *defaults = _defaultObject();
+		uint16_t torn = EEPROM_Checksum::TORN;
+		uint8_t *data = image + (_adr_object - _adr_base);
+
+		if ((defaults == NULL) || (_object == NULL) || (_group != NULL) || !_budget.consume())
+		{
+			return 0;
+		}
+		memcpy(_object, defaults, sizeof(OBJ));
+		offset = _adr_checksum - _adr_base;
+		memcpy(image + offset, &torn, sizeof(torn));
+		if (_defaults != NULL)
+		{
+			// Overlay of the defaults themselves: no chunks stored
+			memset(data, 0, OVERLAY_BITMAP);
+			_imageLength = OVERLAY_BITMAP;
+		}
+		else
+		{
+			memcpy(data, _object, sizeof(OBJ));
+		}
+		_checksum = EEPROM_Checksum::seal(EEPROM_Checksum::calculate(data, _imageLength));
+		_pending = false;
+		_generation++;
+		_countWrite(_adr_checksum, sizeof(torn) + _imageLength);
+		_writeCount++;
+		return (_adr_object - _adr_base) + _imageLength;
+	}
+
+	/**
+	 * @brief Write the checksum of an image built by buildDefaults() and written by the caller
+	 * 
+	 */
+	void sealDefaults()
+	{
+		EEPROM_TRACE_SPAN(TRACE_CHECKSUM, _adr_checksum, sizeof(OBJ));
+		uint16_t temp = _checksum;
+
+		EEPROM_PUT(_adr_checksum, temp);
+		_countWrite(_adr_checksum, sizeof(temp));
+		_generation++;
+		_verifiedGeneration = _generation;
+		_verifiedValid = true;
+		Log.trace("EEPROM Checksum Updated: 0x%04X", temp);
+	}
+
+	/**
+	 * @brief Reset the attached object to the defaults given to setDefaults() and write it
+	 * 
+	 * @return true Defaults written
+	 * @return false No defaults set
+	 */
+	bool loadDefaults()
+	{
+		if (_defaults == NULL)
+		{
+			return false;
+		}
+		memcpy(_object, _defaults, sizeof(OBJ));
+		writeObject(*_object);
+		return true;
 	}
 
 	/**
 	 * @brief Write object to EEPROM
 	 * 
+	 * If the instance belongs to a commit group, the write is deferred until the group is committed.
+	 * 
 	 * @param object 
 	 */
 	void writeObject(OBJ &object)
 	{
-		EEPROM.put(_adr_object, object);
-		_setChecksum();
+		_object = &object;
+		if (_group != NULL)
+		{
+			_pending = true;
+			return;
+		}
+		if (!_budget.consume())
+		{
+			if (!_pending)
+			{
+				Log.warn("EEPROM wear budget exhausted, write held.");
+			}
+			_pending = true;
+			return;
+		}
+		_pending = false;
+		_commitObject();
+	}
+
+	/**
+	 * @brief Write an update held by the wear budget once the budget allows it
+	 * 
+	 * Call periodically (e.g. from loop()) when a wear budget is set.
+	 * 
+	 * @return true Held update written
+	 * @return false Nothing written
+	 */
+	bool process()
+	{
+		if (_pending && (_group == NULL) && _budget.consume())
+		{
+			_pending = false;
+			_commitObject();
+			return true;
+		}
+		return false;
 	}
 
+	/**
+	 * @brief Write an update held by the wear budget now, ignoring the rate limit
+	 * 
+	 * Held updates live in RAM only. Call before a reset, sleep or power down that would lose them.
+	 * The write is charged to the lifetime count, and refused if the lifetime limit is reached.
+	 * 
+	 * @return true Held update written
+	 * @return false Nothing held, held by a commit group, or lifetime limit reached
+	 */
+	bool flush()
+	{
+		if (_pending && (_group == NULL) && _budget.consume(true))
+		{
+			_pending = false;
+			_commitObject();
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Set the wear budget for this object
+	 * 
+	 * Writes made through a commit group are not charged to the budget.
+	 * 
+	 * @param writesPerHour Maximum sustained writes per hour, 0 for no rate limit
+	 * @param lifetimeWrites Maximum total writes, 0 for no limit
+	 */
+	void setWearBudget(uint32_t writesPerHour, uint32_t lifetimeWrites = 0)
+	{
+		_budget.configure(writesPerHour, lifetimeWrites);
+	}
+
+	/**
+	 * @brief Get the wear budget, e.g. to set a simulated clock or restore a lifetime count
+	 * 
+	 * @return EEPROM_WearBudget& wear budget
+	 */
+	EEPROM_WearBudget &getWearBudget() { return _budget; }
+
+	/**
+	 * @brief Get the number of writes currently available under the wear budget
+	 * 
+	 * @return uint32_t available writes, EEPROM_WearBudget::UNLIMITED if no rate limit
+	 */
+	uint32_t getRemainingWrites() { return _budget.getRemaining(); }
+
+	/**
+	 * @brief Get the number of writes left under the lifetime limit
+	 * 
+	 * @return uint32_t remaining writes, EEPROM_WearBudget::UNLIMITED if no lifetime limit
+	 */
+	uint32_t getRemainingLifetimeWrites() { return _budget.getRemainingLifetime(); }
+
+	/**
+	 * @brief Get the writes charged to the wear budget so far, to persist across resets
+	 * 
+	 * Restore the persisted count with getWearBudget().setLifetimeWrites().
+	 * 
+	 * @return uint32_t writes made
+	 */
+	uint32_t getLifetimeWrites() { return _budget.getLifetimeWrites(); }
+
+	/**
+	 * @brief Write a deferred object update to EEPROM, if one is pending
+	 * 
+	 */
+	void commitPending()
+	{
+		if (_pending)
+		{
+			_pending = false;
+			_commitObject();
+		}
+	}
+
+	/**
+	 * @brief Get the checksum of the EEPROM object image
+	 * 
+	 * @return uint16_t stored checksum
+	 */
+	uint16_t getChecksum() { return _checksum; }
+
 	/**
 	 * @brief Read the object from EEPROM if checksum valid
 	 * 
@@ -103,9 +464,19 @@ public:
 	 */
 	bool readObject(OBJ &object)
 	{
+		EEPROM_TRACE_SPAN(TRACE_READ, _adr_object, sizeof(OBJ));
+		_object = &object;
 		if (_verifyChecksum())
 		{
-			EEPROM.get(_adr_object, object);
+			if (_defaults != NULL)
+			{
+				_getOverlay(object);
+			}
+			else
+			{
+				EEPROM.get(_adr_object, object);
+				_bytesRead += sizeof(OBJ);
+			}
 			Log.trace("EEPROM object image Loaded.");
 			return true;
 		}
@@ -116,17 +487,145 @@ public:
 		}
 	}
 
+	/**
+	 * @brief Export the object as a snapshot (see EEPROM_Snapshot.h)
+	 * 
+	 * OBJ must have a snapshot type tag, declared with EEPROM_SNAPSHOT_TAG().
+	 * 
+	 * @param buffer Destination buffer, at least SNAPSHOT_SIZE bytes
+	 * @param length Size of the destination buffer
+	 * @return size_t Snapshot length, 0 if the buffer is too small or no object is loaded
+	 */
+	size_t exportSnapshot(uint8_t *buffer, size_t length)
+	{
+		if (_object == NULL)
+		{
+			return 0;
+		}
+		return EEPROM_Snapshot::encode(_object, sizeof(OBJ), EEPROM_Snapshot::typeTag<OBJ>(), buffer, length);
+	}
+
+	/**
+	 * @brief Validate a snapshot and load it into the object with a single write
+	 * 
+	 * The snapshot must be of this object type, pass its checksum and pass _validateImage() (e.g. field ranges).
+	 * Outside a commit group, the wear budget must also allow the write now: an import is never held.
+	 * 
+	 * @param buffer Snapshot
+	 * @param length Snapshot length
+	 * @param object Object to receive the snapshot data
+	 * @return true Snapshot loaded and written
+	 * @return false Snapshot invalid or wear budget exhausted, object unchanged
+	 */
+	bool importSnapshot(const uint8_t *buffer, size_t length, OBJ &object)
+	{
+		const uint8_t *data = EEPROM_Snapshot::decode(buffer, length, sizeof(OBJ), EEPROM_Snapshot::typeTag<OBJ>());
+
+		if ((data == NULL) || !_validateImage(data))
+		{
+			Log.error("EEPROM snapshot invalid.");
+			return false;
+		}
+		if ((_group == NULL) && ((_budget.getRemaining() == 0) || (_budget.getRemainingLifetime() == 0)))
+		{
+			Log.warn("EEPROM wear budget exhausted, snapshot not imported.");
+			return false;
+		}
+
+		memcpy(&object, data, sizeof(OBJ));
+		writeObject(object);
+		Log.trace("EEPROM snapshot imported.");
+		return true;
+	}
+
+	/** @brief Size of a snapshot of the object (bytes), for sizing export buffers
+	 */
+	static const size_t SNAPSHOT_SIZE = EEPROM_Snapshot::HEADER_SIZE + sizeof(OBJ);
+
+	/**
+	 * @brief Get the Size of a snapshot of the object
+	 * 
+	 * @return size_t snapshot size
+	 */
+	static size_t getSnapshotSize() { return SNAPSHOT_SIZE; }
+
+	/**
+	 * @brief Scrub status returned by scrub()
+	 */
+	enum ScrubStatus
+	{
+		SCRUB_IN_PROGRESS,	//!< More of the image remains to be read
+		SCRUB_VALID,		//!< Full pass complete, checksum valid
+		SCRUB_INVALID		//!< Full pass complete, checksum invalid
+	};
+
 	/**
 	 * @brief Verify Checksum (Public)
 	 * 
+	 * The result is cached: unless the object has been written since the last verification, the cached
+	 * result is returned without reading EEPROM. Use deep = true (or scrub()) after the EEPROM may have
+	 * been changed by other means.
+	 * 
+	 * @param deep true to always re-read the image from EEPROM
 	 * @return true Checksum valid
 	 * @return false Checksum invalid
 	 */
-	bool verifyChecksum()
+	bool verifyChecksum(bool deep = false)
 	{
+		if (!deep && (_verifiedGeneration == _generation))
+		{
+			EEPROM_TRACE_SPAN(TRACE_VERIFY_CACHED, _adr_checksum, 0);
+			return _verifiedValid;
+		}
 		return _verifyChecksum();
 	}
 
+	/**
+	 * @brief Incrementally re-read and verify the image from EEPROM
+	 * 
+	 * Each call checksums up to maxBytes of the image, continuing where the previous call left off.
+	 * A write during the pass restarts it. The result of a completed pass updates the verifyChecksum() cache.
+	 * 
+	 * @param maxBytes Maximum number of bytes to read in this call
+	 * @return ScrubStatus SCRUB_IN_PROGRESS until a full pass completes
+	 */
+	ScrubStatus scrub(size_t maxBytes = 32)
+	{
+		if (_scrubGeneration != _generation)
+		{
+			_scrubGeneration = _generation;
+			_scrubOffset = 0;
+			_scrubSum = 0;
+		}
+
+		size_t end = min(_scrubOffset + maxBytes, _imageLength);
+		_bytesRead += end - _scrubOffset;
+		for (; _scrubOffset < end; _scrubOffset++)
+		{
+			_scrubSum += EEPROM.read(_adr_object + _scrubOffset);
+		}
+
+		if (_scrubOffset < _imageLength)
+		{
+			return SCRUB_IN_PROGRESS;
+		}
+
+		uint16_t checkSum;
+		EEPROM.get(_adr_checksum, checkSum);
+		_bytesRead += sizeof(checkSum);
+
+		_verifiedGeneration = _generation;
+		_verifiedValid = (checkSum == EEPROM_Checksum::seal(_scrubSum));
+		_scrubOffset = 0;
+		_scrubSum = 0;
+
+		if (!_verifiedValid)
+		{
+			Log.error("EEPROM scrub: checksum invalid.");
+		}
+		return _verifiedValid ? SCRUB_VALID : SCRUB_INVALID;
+	}
+
 	/**
 	 * @brief Get the Size of the object
 	 * 
@@ -134,8 +633,71 @@ public:
 	 */
 	size_t getSize() { return _eepromSize;}
 
+	/**
+	 * @brief Get the number of object writes since startup or resetCounters()
+	 * 
+	 * @return uint32_t write count
+	 */
+	uint32_t getWriteCount() { return _writeCount; }
+
+	/**
+	 * @brief Get the number of bytes written (object and checksum)
+	 * 
+	 * @return uint32_t byte count
+	 */
+	uint32_t getBytesWritten() { return _bytesWritten; }
+
+	/**
+	 * @brief Get the number of bytes read (object, checksum and checksum verification)
+	 * 
+	 * @return uint32_t byte count
+	 */
+	uint32_t getBytesRead() { return _bytesRead; }
+
+	/**
+	 * @brief Get the number of emulation records touched by writes
+	 * 
+	 * Each write is charged one count for every LAYOUT::RECORD_SIZE record it overlaps. This is the
+	 * figure that drives page compaction in flash-emulated EEPROM.
+	 * 
+	 * @return uint32_t record count
+	 */
+	uint32_t getRecordsWritten() { return _recordsWritten; }
+
+	/**
+	 * @brief Reset the write counters
+	 * 
+	 */
+	void resetCounters()
+	{
+		_writeCount = 0;
+		_bytesWritten = 0;
+		_bytesRead = 0;
+		_recordsWritten = 0;
+	}
+
 
 protected:
+	/**
+	 * @brief Check the object bytes of a snapshot before they are imported. Accepts any object by default.
+	 * 
+	 * @param data Object bytes, sizeof(OBJ), possibly unaligned
+	 * @return true Object valid
+	 * @return false Object rejected, not imported
+	 */
+	virtual bool _validateImage(const uint8_t *data)
+	{
+		(void)data;
+		return true;
+	}
+
+	/**
+	 * @brief Get the defaults built by buildDefaults(): those given to setDefaults() by default
+	 * 
+	 * @return const OBJ* defaults, NULL if none
+	 */
+	virtual const OBJ *_defaultObject() { return _defaults; }
+
 /******************************************************************************
  * Private members
  ******************************************************************************/
@@ -150,6 +712,10 @@ protected:
 	 */
 	size_t _adr_checksum;
 
+	/** @brief Address given to begin(): start of the memory block, before any alignment padding
+	 */
+	uint16_t _adr_base;
+
 	/** @brief Total memory size of the data object (bytes)
 	 */
 	size_t _eepromSize;
@@ -158,6 +724,113 @@ protected:
 	 */
 	uint16_t _checksum;
 
+	/** @brief RAM copy of the data object, written when a deferred update is committed
+	 */
+	OBJ *_object = NULL;
+
+	/** @brief Write rate limiter
+	 */
+	EEPROM_WearBudget _budget;
+
+	/** @brief Object writes since startup
+	 */
+	uint32_t _writeCount = 0;
+
+	/** @brief Bytes written since startup
+	 */
+	uint32_t _bytesWritten = 0;
+
+	/** @brief Defaults for overlay mode, NULL in normal mode
+	 */
+	const OBJ *_defaults = NULL;
+
+	/** @brief Number of bytes covered by the checksum: the object, or the overlay bitmap and chunks
+	 */
+	size_t _imageLength = sizeof(OBJ);
+
+	/** @brief Write generation, advanced by every write to the image
+	 */
+	uint32_t _generation = 1;
+
+	/** @brief Generation of the last completed verification
+	 */
+	uint32_t _verifiedGeneration = 0;
+
+	/** @brief Result of the last completed verification
+	 */
+	bool _verifiedValid = false;
+
+	/** @brief Generation being scrubbed
+	 */
+	uint32_t _scrubGeneration = 0;
+
+	/** @brief Scrub position within the object
+	 */
+	size_t _scrubOffset = 0;
+
+	/** @brief Partial checksum of the scrub pass
+	 */
+	uint16_t _scrubSum = 0;
+
+	/** @brief Bytes read since startup
+	 */
+	uint32_t _bytesRead = 0;
+
+	/** @brief Emulation records touched since startup
+	 */
+	uint32_t _recordsWritten = 0;
+
+	/**
+	 * @brief Assign EEPROM addresses and load the stored checksum
+	 * 
+	 * The image occupies LAYOUT-aligned space: checksum, object, then padding to the next record boundary.
+	 * 
+	 * @param address: EEPROM relative address for the saved object
+	 */
+	void _setAddress(uint16_t address)
+	{
+		_assignAddress(address);
+		EEPROM.get(_adr_checksum, _checksum);
+		_bytesRead += sizeof(_checksum);
+		Log.trace("_adr_checksum: %d, _adr_object: %d, _eepromSize: %d, checksum: 0x%04X", _adr_checksum, _adr_object, _eepromSize, _checksum);
+	}
+
+	/**
+	 * @brief Assign EEPROM addresses
+	 * 
+	 * An address that is not on a LAYOUT record boundary is rounded up to the next one. The skipped bytes are
+	 * included in getSize(), so that address + getSize() is still the next free address.
+	 * 
+	 * @param address: EEPROM relative address for the saved object
+	 */
+	void _assignAddress(uint16_t address)
+	{
+		size_t aligned = LAYOUT::align(address);
+
+		if (aligned != address)
+		{
+			Log.warn("EEPROM object address %d not aligned to %d-byte records, using %d.", address, LAYOUT::RECORD_SIZE, aligned);
+		}
+		_generation++;
+		_adr_base = address;
+		_adr_checksum = aligned;
+		_adr_object = _adr_checksum + sizeof(_checksum);
+		_eepromSize = (aligned - address) + LAYOUT::align(sizeof(OBJ) + sizeof(_checksum) + ((_defaults != NULL) ? OVERLAY_BITMAP : 0));
+		_imageLength = (_defaults != NULL) ? OVERLAY_BITMAP : sizeof(OBJ);
+	}
+
+	/**
+	 * @brief Update write counters for a block written to EEPROM
+	 * 
+	 * @param address Start address of the write
+	 * @param length Number of bytes written
+	 */
+	void _countWrite(size_t address, size_t length)
+	{
+		_bytesWritten += length;
+		_recordsWritten += (address + length - 1) / LAYOUT::RECORD_SIZE - address / LAYOUT::RECORD_SIZE + 1;
+	}
+
 	/** 
 	 * @brief Verifies checksum stored for the data block (Private)
 	 * 
@@ -166,16 +839,28 @@ protected:
 	 */
 	bool _verifyChecksum()
 	{
+		EEPROM_TRACE_SPAN(TRACE_VERIFY, _adr_checksum, sizeof(OBJ));
 		uint16_t temp;
 		uint16_t checkSum;
 
 		// Retrieve stored checksum value
 		EEPROM.get(_adr_checksum, checkSum);
+		_bytesRead += sizeof(checkSum);
+
+		if ((_defaults != NULL) && !_loadOverlayLength())
+		{
+			_verifiedGeneration = _generation;
+			_verifiedValid = false;
+			Log.error("EEPROM overlay bitmap invalid.");
+			return false;
+		}
 
 		temp = _calcChecksum();
 
 		Log.trace("Stored Checksum: 0x%04X, Calculated: 0x%04X", checkSum, temp);
 
+		_verifiedGeneration = _generation;
+		_verifiedValid = (checkSum == temp);
 		if (checkSum == temp)
 		{
 			Log.info("EEPROM User Settings Checksum valid.");
@@ -193,21 +878,50 @@ protected:
  ******************************************************************************/
 
 private:
-	/** 
-	 * @brief Calculates and stores checksum in EEPROM
+	/**
+	 * @brief Write the RAM copy of the object and its checksum to EEPROM
+	 * 
+	 * The checksum is set to EEPROM_Checksum::TORN first, so that an image cut by power loss never passes.
 	 */
-	void _setChecksum()
+	void _commitObject()
 	{
-		uint16_t temp = 0;
+		EEPROM_TRACE_SPAN(TRACE_WRITE, _adr_object, sizeof(OBJ));
+		uint16_t torn = EEPROM_Checksum::TORN;
 
-		for (size_t i = _adr_object; i < (_adr_checksum + _eepromSize); i++)
+		EEPROM_PUT(_adr_checksum, torn);
+		_countWrite(_adr_checksum, sizeof(torn));
+		if (_defaults != NULL)
 		{
-			temp += EEPROM.read(i);
+			EEPROM_TRACE_SPAN(TRACE_PUT, _adr_object, sizeof(OBJ));
+			_putOverlay();
+		}
+		else
+		{
+			EEPROM_TRACE_SPAN(TRACE_PUT, _adr_object, sizeof(OBJ));
+			EEPROM_PUT(_adr_object, *_object);
+			_countWrite(_adr_object, sizeof(OBJ));
 		}
+		_generation++;
+		_setChecksum();
+		_writeCount++;
+	}
+
+	/** 
+	 * @brief Calculates and stores checksum in EEPROM
+	 */
+	void _setChecksum()
+	{
+		EEPROM_TRACE_SPAN(TRACE_CHECKSUM, _adr_checksum, sizeof(OBJ));
+		uint16_t temp = _calcChecksum();
 
-		EEPROM.put(_adr_checksum, temp);
+		EEPROM_PUT(_adr_checksum, temp);
+		_countWrite(_adr_checksum, sizeof(temp));
 		_checksum = temp;
 
+		// The checksum was just calculated from the media, so the image is known valid
+		_verifiedGeneration = _generation;
+		_verifiedValid = true;
+
 		Log.trace("EEPROM Checksum Updated: 0x%04X", temp);
 	}
 
@@ -219,12 +933,150 @@ private:
 	uint16_t _calcChecksum()
 	{
 		uint16_t temp = 0;
+		uint8_t block[32];
+		size_t i = _adr_object;
 
-		// Compute Checksum over the full EEPROM Space
-		for (size_t i = _adr_object; i < (_adr_checksum + _eepromSize); i++)
+		// Compute Checksum over the object image, a block at a time
+		for (; i + sizeof(block) <= (_adr_object + _imageLength); i += sizeof(block))
+		{
+			EEPROM.get(i, block);
+			temp = EEPROM_Checksum::calculate(block, sizeof(block), temp);
+		}
+		for (; i < (_adr_object + _imageLength); i++)
 		{
 			temp += EEPROM.read(i);
 		}
-		return temp;
+		_bytesRead += _imageLength;
+		return EEPROM_Checksum::seal(temp);
+	}
+
+	/**
+	 * @brief Length of an overlay chunk (the last chunk may be short)
+	 * 
+	 * @param chunk Chunk number
+	 * @return size_t chunk length
+	 */
+	static size_t _chunkLength(size_t chunk)
+	{
+		size_t remaining = sizeof(OBJ) - chunk * OVERLAY_CHUNK;
+		return (remaining < OVERLAY_CHUNK) ? remaining : OVERLAY_CHUNK;
+	}
+
+	/**
+	 * @brief Write the chunks of the object that differ from the defaults, then the bitmap
+	 */
+	void _putOverlay()
+	{
+		const uint8_t *data = reinterpret_cast<const uint8_t *>(_object);
+		const uint8_t *defaults = reinterpret_cast<const uint8_t *>(_defaults);
+		uint8_t bitmap[OVERLAY_BITMAP];
+		size_t address = _adr_object + OVERLAY_BITMAP;
+
+		memset(bitmap, 0, sizeof(bitmap));
+		for (size_t chunk = 0; chunk < OVERLAY_CHUNKS; chunk++)
+		{
+			size_t offset = chunk * OVERLAY_CHUNK;
+			size_t length = _chunkLength(chunk);
+
+			if (memcmp(&data[offset], &defaults[offset], length) != 0)
+			{
+				bitmap[chunk / 8] |= 1 << (chunk % 8);
+				for (size_t i = 0; i < length; i++)
+				{
+					EEPROM_WRITE(address++, data[offset + i]);
+				}
+			}
+		}
+		EEPROM_PUT(_adr_object, bitmap);
+
+		_imageLength = address - _adr_object;
+		_countWrite(_adr_object, _imageLength);
+	}
+
+	/**
+	 * @brief Read the overlay bitmap from EEPROM and set the image length from it
+	 * 
+	 * @return true Bitmap valid
+	 * @return false Bitmap has bits set beyond the last chunk
+	 */
+	bool _loadOverlayLength()
+	{
+		uint8_t bitmap[OVERLAY_BITMAP];
+
+		EEPROM.get(_adr_object, bitmap);
+		_bytesRead += sizeof(bitmap);
+		return _overlayLength(bitmap);
+	}
+
+	/**
+	 * @brief Set the image length from an overlay bitmap
+	 * 
+	 * @param bitmap Overlay bitmap
+	 * @return true Bitmap valid
+	 * @return false Bitmap has bits set beyond the last chunk
+	 */
+	bool _overlayLength(const uint8_t *bitmap)
+	{
+		_imageLength = OVERLAY_BITMAP;
+		for (size_t chunk = 0; chunk < OVERLAY_BITMAP * 8; chunk++)
+		{
+			if (bitmap[chunk / 8] & (1 << (chunk % 8)))
+			{
+				if (chunk >= OVERLAY_CHUNKS)
+				{
+					return false;
+				}
+				_imageLength += _chunkLength(chunk);
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Load the object from a RAM copy of an overlay image: defaults, with the stored chunks merged over them
+	 * 
+	 * @param image Overlay bitmap followed by the stored chunks
+	 * @param object 
+	 */
+	void _mergeOverlay(const uint8_t *image, OBJ &object)
+	{
+		uint8_t *data = reinterpret_cast<uint8_t *>(&object);
+		const uint8_t *stored = image + OVERLAY_BITMAP;
+
+		memcpy(data, _defaults, sizeof(OBJ));
+		for (size_t chunk = 0; chunk < OVERLAY_CHUNKS; chunk++)
+		{
+			if (image[chunk / 8] & (1 << (chunk % 8)))
+			{
+				memcpy(&data[chunk * OVERLAY_CHUNK], stored, _chunkLength(chunk));
+				stored += _chunkLength(chunk);
+			}
+		}
+	}
+
+	/**
+	 * @brief Load the object: defaults, with the stored chunks merged over them
+	 * 
+	 * @param object 
+	 */
+	void _getOverlay(OBJ &object)
+	{
+		uint8_t *data = reinterpret_cast<uint8_t *>(&object);
+		uint8_t bitmap[OVERLAY_BITMAP];
+		size_t address = _adr_object + OVERLAY_BITMAP;
+
+		memcpy(data, _defaults, sizeof(OBJ));
+		EEPROM.get(_adr_object, bitmap);
+		for (size_t chunk = 0; chunk < OVERLAY_CHUNKS; chunk++)
+		{
+			if (bitmap[chunk / 8] & (1 << (chunk % 8)))
+			{
+				for (size_t i = 0; i < _chunkLength(chunk); i++)
+				{
+					data[chunk * OVERLAY_CHUNK + i] = EEPROM.read(address++);
+				}
+			}
+		}
+		_bytesRead += _imageLength;
 	}
 };
@@ -0,0 +1,272 @@
+/**
+ * @file EEPROM_CommitGroup.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief EEPROM Commit Group Class Member Functions
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+
+#include <Particle.h>
+#include "EEPROM_CommitGroup.h"
+#include "EEPROM_Checksum.h"
+#include "EEPROM_Fault.h"
+
+EEPROM_CommitGroup::~EEPROM_CommitGroup()
+{
+	while (_first != NULL)
+	{
+		_remove(*_first);
+	}
+}
+
+bool EEPROM_CommitGroup::begin(uint16_t address)
+{
+	_adr_marker = address;
+	Log.trace("_adr_marker: %d", _adr_marker);
+	return !_rollBack();
+}
+
+void EEPROM_CommitGroup::join(EEPROM_Object &member)
+{
+	if (member._group != NULL)
+	{
+		Log.warn("EEPROM object already in a commit group.");
+		return;
+	}
+
+	member._group = this;
+	member._nextMember = NULL;
+	if (_last == NULL)
+	{
+		_first = &member;
+	}
+	else
+	{
+		_last->_nextMember = &member;
+	}
+	_last = &member;
+	_count++;
+}
+
+void EEPROM_CommitGroup::leave(EEPROM_Object &member)
+{
+	if (member._group != this)
+	{
+		return;
+	}
+	_remove(member);
+	member.commitPending();
+}
+
+void EEPROM_CommitGroup::_remove(EEPROM_Object &member)
+{
+	EEPROM_Object **link = &_first;
+	EEPROM_Object *previous = NULL;
+
+	while ((*link != NULL) && (*link != &member))
+	{
+		previous = *link;
+		link = &(*link)->_nextMember;
+	}
+	if (*link == NULL)
+	{
+		return;
+	}
+
+	*link = member._nextMember;
+	if (_last == &member)
+	{
+		_last = previous;
+	}
+	member._group = NULL;
+	member._nextMember = NULL;
+	_count--;
+}
+
+size_t EEPROM_CommitGroup::commit()
+{
+	size_t written = 0;
+
+	if (!isPending())
+	{
+		return 0;
+	}
+
+	// Save the images about to change, then open the marker before touching any of them
+	_writeJournal();
+	EEPROM_WRITE(_adr_marker, MARKER_OPEN);
+
+	for (EEPROM_Object *member = _first; member != NULL; member = member->_nextMember)
+	{
+		if (member->isPending())
+		{
+			member->commitPending();
+			written++;
+		}
+	}
+
+	// Close the marker: count and checksum first, so that the state byte completes the commit
+	Marker marker = {MARKER_COMPLETE, _count, _combinedChecksum()};
+	EEPROM_PUT(_adr_marker + offsetof(Marker, count), marker.count);
+	EEPROM_PUT(_adr_marker + offsetof(Marker, checksum), marker.checksum);
+	EEPROM_WRITE(_adr_marker, marker.state);
+	EEPROM_WRITE(_adr_marker + sizeof(Marker), JOURNAL_EMPTY);
+
+	Log.trace("EEPROM commit group: %d of %d members written, checksum: 0x%04X", written, _count, marker.checksum);
+	return written;
+}
+bool EEPROM_CommitGroup::verify()
+{
+	Marker marker;
+
+	EEPROM.get(_adr_marker, marker);
+
+	if ((marker.state == MARKER_COMPLETE) && (marker.count == _count) && (marker.checksum == _combinedChecksum()))
+	{
+		Log.info("EEPROM commit group complete.");
+		return true;
+	}
+	else
+	{
+		Log.error("EEPROM commit group incomplete.");
+		return false;
+	}
+}
+
+bool EEPROM_CommitGroup::isPending()
+{
+	for (EEPROM_Object *member = _first; member != NULL; member = member->_nextMember)
+	{
+		if (member->isPending())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+uint16_t EEPROM_CommitGroup::_combinedChecksum()
+{
+	uint16_t temp = 0;
+
+	for (EEPROM_Object *member = _first; member != NULL; member = member->_nextMember)
+	{
+		temp += member->getChecksum();
+	}
+	return temp;
+}
+
+size_t EEPROM_CommitGroup::getSize()
+{
+	size_t size = sizeof(Marker) + sizeof(JournalHeader);
+
+	for (EEPROM_Object *member = _first; member != NULL; member = member->_nextMember)
+	{
+		size += sizeof(JournalEntry) + member->getSize();
+	}
+	return size;
+}
+
+void EEPROM_CommitGroup::_copy(size_t from, size_t to, size_t length, uint16_t &sum)
+{
+	uint8_t block[32];
+
+	for (size_t i = 0; i < length; i += sizeof(block))
+	{
+		size_t count = min(sizeof(block), length - i);
+
+		HAL_EEPROM_Get(from + i, block, count);
+		sum = EEPROM_Checksum::calculate(block, count, sum);
+		for (size_t j = 0; j < count; j++)
+		{
+			EEPROM_WRITE(to + i + j, block[j]);
+		}
+	}
+}
+
+void EEPROM_CommitGroup::_writeJournal()
+{
+	size_t adr_journal = _adr_marker + sizeof(Marker);
+	size_t address = adr_journal + sizeof(JournalHeader);
+	JournalHeader header;
+
+	// Invalidate before overwriting the entries of the previous commit
+	EEPROM_WRITE(adr_journal, JOURNAL_EMPTY);
+
+	header.reserved = 0;
+	header.checksum = 0;
+	for (EEPROM_Object *member = _first; member != NULL; member = member->_nextMember)
+	{
+		if (member->isPending())
+		{
+			JournalEntry entry = {member->getAddress(), (uint16_t)member->getSize()};
+
+			EEPROM_PUT(address, entry);
+			header.checksum = EEPROM_Checksum::calculate(&entry, sizeof(entry), header.checksum);
+			_copy(entry.address, address + sizeof(entry), entry.length, header.checksum);
+			address += sizeof(entry) + entry.length;
+		}
+	}
+	header.length = address - (adr_journal + sizeof(JournalHeader));
+	EEPROM.get(_adr_marker, header.previous);
+
+	// The journal becomes valid with its state byte, written last
+	header.state = JOURNAL_EMPTY;
+	EEPROM_PUT(adr_journal, header);
+	EEPROM_WRITE(adr_journal, JOURNAL_VALID);
+}
+
+bool EEPROM_CommitGroup::_rollBack()
+{
+	size_t adr_journal = _adr_marker + sizeof(Marker);
+	size_t first = adr_journal + sizeof(JournalHeader);
+	JournalHeader header;
+	Marker marker;
+	uint16_t sum = 0;
+	uint8_t block[32];
+
+	EEPROM.get(adr_journal, header);
+	if ((header.state != JOURNAL_VALID) || (first + header.length > EEPROM.length()))
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < header.length; i += sizeof(block))
+	{
+		size_t count = min(sizeof(block), header.length - i);
+
+		HAL_EEPROM_Get(first + i, block, count);
+		sum = EEPROM_Checksum::calculate(block, count, sum);
+	}
+	if (sum != header.checksum)
+	{
+		Log.error("EEPROM commit group journal invalid.");
+		EEPROM_WRITE(adr_journal, JOURNAL_EMPTY);
+		return false;
+	}
+
+	EEPROM.get(_adr_marker, marker);
+	if (marker.state == MARKER_COMPLETE)
+	{
+		// The commit completed, or had not yet started on the members
+		EEPROM_WRITE(adr_journal, JOURNAL_EMPTY);
+		return false;
+	}
+
+	Log.warn("EEPROM commit group interrupted, rolling back.");
+	for (size_t address = first; address < first + header.length;)
+	{
+		JournalEntry entry;
+
+		EEPROM.get(address, entry);
+		address += sizeof(entry);
+		_copy(address, entry.address, entry.length, sum);
+		address += entry.length;
+	}
+	EEPROM_PUT(_adr_marker, header.previous);
+	EEPROM_WRITE(adr_journal, JOURNAL_EMPTY);
+	return true;
+}
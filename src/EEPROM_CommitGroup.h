@@ -0,0 +1,228 @@
+/**
+ * @file EEPROM_CommitGroup.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief EEPROM Commit Group Class Header
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#pragma once
+#include <Particle.h>
+#include "EEPROM_Object.h"
+
+/**
+ * @brief EEPROM Commit Group
+ * 
+ * Batches the writes of several EEPROM_Class instances (of any object type) into a single atomic commit.
+ * 
+ * Once an instance has joined a group, writeObject() and the UserSettingsClass setters only update the
+ * RAM copy and mark the object pending. commit() then writes every pending member in join order, so repeated
+ * changes to an object cost one write and one checksum pass.
+ * 
+ * Commits are atomic: either every pending member is updated, or none is. Before any member image is
+ * written, commit() copies the current images of the pending members to a journal in EEPROM following the
+ * group's completion marker. If power is lost before the commit completes, begin() on the next startup
+ * copies the journaled images back, restoring all members to their state before the commit. begin() must
+ * therefore be called before the members are loaded.
+ * 
+ * The group occupies getSize() bytes: the marker, the journal header and room to journal every member.
+ * Call getSize() after all members have joined.
+ * 
+ * A member that is destroyed leaves its group.
+ * 
+ * @code
+ *     EEPROM_CommitGroup myGroup;
+ *     myGroup.begin(groupAddress);     // Rolls back an interrupted commit
+ *     myGroup.join(mySettings);
+ *     myGroup.join(myEEPROM);
+ *     mySettings.begin(settingsAddress);
+ *     myEEPROM.begin(objectAddress, myCredentials);
+ * 
+ *     mySettings.setTimeZone(-8);
+ *     myEEPROM.writeObject(myCredentials);
+ *     myGroup.commit();
+ * @endcode
+ */
+class EEPROM_CommitGroup
+{
+public:
+	/**
+	 * @brief Construct a new commit group object
+	 * 
+	 */
+	EEPROM_CommitGroup()
+	{
+		Log.trace("in EEPROM_CommitGroup Constructor.");
+	}
+
+	/**
+	 * @brief Remove all members from the group
+	 * 
+	 */
+	~EEPROM_CommitGroup();
+
+	/**
+	 * @brief Assign the EEPROM address of the group, and roll back a commit interrupted by power loss
+	 * 
+	 * Call before the members are loaded.
+	 * 
+	 * @param address: EEPROM relative address for the marker and journal
+	 * @return true EEPROM unchanged
+	 * @return false An interrupted commit was rolled back
+	 */
+	bool begin(uint16_t address);
+
+	/**
+	 * @brief Add an EEPROM_Class instance to the group
+	 * 
+	 * @param member instance to add; subsequent writes are deferred until commit()
+	 */
+	void join(EEPROM_Object &member);
+
+	/**
+	 * @brief Remove an instance from the group; its subsequent writes are immediate
+	 * 
+	 * A pending update of the member is written first.
+	 * 
+	 * @param member instance to remove
+	 */
+	void leave(EEPROM_Object &member);
+
+	/**
+	 * @brief Journal the pending members, write them to EEPROM in join order, then close the completion marker
+	 * 
+	 * @return size_t number of members written
+	 */
+	size_t commit();
+
+	/**
+	 * @brief Verify that the last commit completed and matches the members' stored checksums
+	 * 
+	 * Call after begin() of all members.
+	 * 
+	 * @return true Last commit complete
+	 * @return false Commit interrupted or member images changed outside the group
+	 */
+	bool verify();
+
+	/**
+	 * @brief Check for pending member updates
+	 * 
+	 * @return true One or more members waiting to be written
+	 * @return false All members current
+	 */
+	bool isPending();
+
+	/**
+	 * @brief Get the Size of the group in EEPROM: completion marker and journal
+	 * 
+	 * @return size_t group size
+	 */
+	size_t getSize();
+
+private:
+	/** @brief Completion marker stored in EEPROM
+	 */
+	struct Marker
+	{
+		/** MARKER_OPEN or MARKER_COMPLETE */
+		uint8_t state;
+		/** Number of members in the group */
+		uint8_t count;
+		/** Sum of member checksums */
+		uint16_t checksum;
+	};
+
+	/** @brief Journal header stored in EEPROM after the marker, followed by the journal entries
+	 */
+	struct JournalHeader
+	{
+		/** JOURNAL_VALID while the entries hold the images of a commit in progress */
+		uint8_t state;
+		/** Reserved */
+		uint8_t reserved;
+		/** Length of the entries (bytes) */
+		uint16_t length;
+		/** Checksum of the entries */
+		uint16_t checksum;
+		/** Marker before the commit, restored by a roll back */
+		Marker previous;
+	};
+
+	/** @brief Journal entry header, followed by the member image
+	 */
+	struct JournalEntry
+	{
+		/** Member address */
+		uint16_t address;
+		/** Member image length */
+		uint16_t length;
+	};
+
+	//! @brief Marker state while a commit is in progress
+	static const uint8_t MARKER_OPEN = 0x00;
+	//! @brief Marker state after a commit completed
+	static const uint8_t MARKER_COMPLETE = 0xA5;
+	//! @brief Journal state while it holds the images of a commit in progress
+	static const uint8_t JOURNAL_VALID = 0x5A;
+	//! @brief Journal state when empty
+	static const uint8_t JOURNAL_EMPTY = 0x00;
+
+	/** @brief Address assigned to the marker in EEPROM.
+	 */
+	uint16_t _adr_marker = 0;
+
+	/** @brief First member of the group
+	 */
+	EEPROM_Object *_first = NULL;
+
+	/** @brief Last member of the group
+	 */
+	EEPROM_Object *_last = NULL;
+
+	/** @brief Number of members in the group
+	 */
+	uint8_t _count = 0;
+
+	/**
+	 * @brief Sum of member checksums
+	 * 
+	 * @return uint16_t combined checksum
+	 */
+	uint16_t _combinedChecksum();
+
+	/**
+	 * @brief Copy the current EEPROM images of the pending members to the journal, then mark it valid
+	 * 
+	 */
+	void _writeJournal();
+
+	/**
+	 * @brief Copy the journaled images and marker back, if the journal holds an incomplete commit
+	 * 
+	 * @return true Commit rolled back
+	 * @return false Nothing to roll back
+	 */
+	bool _rollBack();
+
+	/**
+	 * @brief Unlink a member without writing it (see EEPROM_Object destructor)
+	 * 
+	 * @param member instance to remove
+	 */
+	void _remove(EEPROM_Object &member);
+
+	/**
+	 * @brief Copy a block of EEPROM
+	 * 
+	 * @param from Source address
+	 * @param to Destination address
+	 * @param length Number of bytes
+	 * @param sum Checksum, updated with the bytes copied
+	 */
+	static void _copy(size_t from, size_t to, size_t length, uint16_t &sum);
+
+	friend class EEPROM_Object;
+};
@@ -0,0 +1,168 @@
+/**
+ * @file EEPROM_Counter.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Wear-leveled Persistent Counter Class Member Functions
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+
+#include <Particle.h>
+#include "EEPROM_Counter.h"
+
+EEPROM_Counter::EEPROM_Counter(size_t regionSize)
+{
+	_regionSize = (regionSize + 3) & ~3;
+	Log.trace("in EEPROM_Counter Constructor.");
+}
+
+bool EEPROM_Counter::begin(uint16_t address)
+{
+	BaseSlot slots[2];
+	bool slotValid[2];
+
+	_adr_base = address;
+	_adr_region = _adr_base + 2 * SLOT_SIZE;
+
+	slotValid[0] = _readSlot(0, slots[0]);
+	slotValid[1] = _readSlot(1, slots[1]);
+	if (!slotValid[0] && !slotValid[1])
+	{
+		Log.error("EEPROM counter base invalid, resetting.");
+		_slot = 1;
+		_sequence = 0;
+		reset();
+		return false;
+	}
+
+	// Use the newest valid slot, comparing sequence numbers modulo 2^16
+	_slot = (slotValid[0] && (!slotValid[1] || ((int16_t)(slots[0].sequence - slots[1].sequence) > 0))) ? 0 : 1;
+	_base = slots[_slot].base;
+	_sequence = slots[_slot].sequence;
+
+	if (EEPROM.read(_adr_base + _slot * SLOT_SIZE + sizeof(BaseSlot)) != SLOT_COMMITTED)
+	{
+		// Power was lost after the new base was written, before the region was erased: finish erasing it
+		Log.warn("EEPROM counter roll-up incomplete, finishing.");
+		_eraseRegion();
+		return true;
+	}
+
+	// Count the cleared bits a word at a time. A valid region is cleared bytes, at most one
+	// partly cleared byte, then erased bytes; anything else is a partly erased region.
+	bool erasedSeen = false;
+	bool valid = true;
+
+	_position = 0;
+	for (size_t i = 0; i < _regionSize; i += sizeof(uint32_t))
+	{
+		uint32_t word;
+		EEPROM.get(_adr_region + i, word);
+		_position += 32 - __builtin_popcount(word);
+
+		if (erasedSeen && (word != 0xFFFFFFFF))
+		{
+			valid = false;
+		}
+		else if (word != 0)
+		{
+			for (size_t n = 0; n < sizeof(word); n++)
+			{
+				uint8_t value = (word >> (n * 8)) & 0xFF;
+
+				if (erasedSeen && (value != 0xFF))
+				{
+					valid = false;
+				}
+				else if (value != 0)
+				{
+					erasedSeen = true;
+					valid = valid && (value == (uint8_t)(0xFF << (8 - __builtin_popcount(value))));
+				}
+			}
+		}
+	}
+
+	if (!valid || (_position == _regionSize * 8))
+	{
+		// Power was lost before the roll-up of a full region wrote its new base: redo it
+		Log.warn("EEPROM counter roll-up incomplete, finishing.");
+		_rollUp(_base + _position);
+	}
+
+	Log.trace("_adr_base: %d, _adr_region: %d, slot: %u, base: %lu, count: %lu", _adr_base, _adr_region, _slot, (unsigned long)_base, (unsigned long)getCount());
+	return true;
+}
+
+uint32_t EEPROM_Counter::increment()
+{
+	size_t index = _position / 8;
+	uint8_t bit = _position % 8;
+
+	// Clear the next bit; bits are cleared from the LSB up
+	EEPROM.write(_adr_region + index, (uint8_t)(0xFF << (bit + 1)));
+	_position++;
+
+	if (_position == _regionSize * 8)
+	{
+		_rollUp(_base + _position);
+	}
+	return getCount();
+}
+
+void EEPROM_Counter::reset(uint32_t value)
+{
+	_rollUp(value);
+}
+
+void EEPROM_Counter::_rollUp(uint32_t value)
+{
+	BaseSlot slot;
+	uint8_t next = _slot ^ 1;
+	size_t address = _adr_base + next * SLOT_SIZE;
+
+	slot.base = value;
+	slot.sequence = _sequence + 1;
+	slot.checksum = _calcChecksum(slot);
+
+	// Mark the slot pending before it can become valid; put() writes the checksum last
+	EEPROM.write(address + sizeof(BaseSlot), SLOT_PENDING);
+	EEPROM.put(address, slot);
+
+	_slot = next;
+	_sequence = slot.sequence;
+	_base = value;
+	_eraseRegion();
+	Log.trace("EEPROM counter rolled up, slot: %u, base: %lu", _slot, (unsigned long)_base);
+}
+
+void EEPROM_Counter::_eraseRegion()
+{
+	for (size_t i = 0; i < _regionSize; i++)
+	{
+		EEPROM.write(_adr_region + i, 0xFF);
+	}
+	EEPROM.write(_adr_base + _slot * SLOT_SIZE + sizeof(BaseSlot), SLOT_COMMITTED);
+	_position = 0;
+}
+
+bool EEPROM_Counter::_readSlot(uint8_t index, BaseSlot &slot)
+{
+	EEPROM.get(_adr_base + index * SLOT_SIZE, slot);
+	return slot.checksum == _calcChecksum(slot);
+}
+
+uint16_t EEPROM_Counter::_calcChecksum(const BaseSlot &slot)
+{
+	uint16_t temp = 0;
+
+	for (size_t i = 0; i < sizeof(slot.base); i++)
+	{
+		temp += (slot.base >> (i * 8)) & 0xFF;
+	}
+	temp += (slot.sequence & 0xFF) + (slot.sequence >> 8);
+	// Complement so that an erased (all 0xFF) slot is never valid
+	return ~temp;
+}
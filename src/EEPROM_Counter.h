@@ -0,0 +1,158 @@
+/**
+ * @file EEPROM_Counter.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Wear-leveled Persistent Counter Class Header
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#pragma once
+#include <Particle.h>
+
+/**
+ * @brief Persistent Counter
+ * 
+ * Non-volatile counter for values that change far more often than settings (boot counts, event tallies,
+ * uptime totals). Rather than rewriting a full object and checksum per change, each increment clears
+ * one bit in a unary region, costing a single byte write. Successive increments move across the region,
+ * spreading wear over every byte. When the region is full, its count is rolled up into a checksummed base
+ * value and the region is erased back to 0xFF.
+ * 
+ * EEPROM layout at the assigned address:
+ * 	- Two base slots (A/B), each a base value (uint32_t), a sequence number, a 16-bit checksum and a state byte.
+ * 	- Unary region of regionSize bytes. Count = base of the newest valid slot + number of cleared bits.
+ * 
+ * A roll-up writes the new base to the older slot, marked pending, and checksums it before the region is
+ * erased; the slot is marked committed once the region is erased. The previous slot stays valid until then,
+ * so a roll-up interrupted by power loss is either redone from the previous base or finished from the new
+ * one, and the count is neither lost nor over counted.
+ */
+class EEPROM_Counter
+{
+public:
+	/**
+	 * @brief Construct a new persistent counter object
+	 * 
+	 * @param regionSize Size of the unary region in bytes (rounded up to a multiple of 4)
+	 */
+	EEPROM_Counter(size_t regionSize = 32);
+
+	/**
+	 * @brief Initialize the counter and load its value from EEPROM
+	 * 
+	 * @param address: EEPROM relative address for the counter
+	 * @return true: Counter loaded
+	 * @return false: Neither base slot valid, counter reset to 0
+	 */
+	bool begin(uint16_t address);
+
+	/**
+	 * @brief Add one to the counter
+	 * 
+	 * @return uint32_t new count
+	 */
+	uint32_t increment();
+
+	/**
+	 * @brief Get the current count
+	 * 
+	 * @return uint32_t count
+	 */
+	uint32_t getCount() { return _base + _position; }
+
+	/**
+	 * @brief Set the counter to a new value
+	 * 
+	 * @param value new count
+	 */
+	void reset(uint32_t value = 0);
+
+	/**
+	 * @brief Get the Size of the counter in EEPROM
+	 * 
+	 * @return size_t counter size
+	 */
+	size_t getSize() { return 2 * SLOT_SIZE + _regionSize; }
+
+private:
+	/**
+	 * @brief Base slot, followed in EEPROM by its state byte
+	 */
+	struct BaseSlot
+	{
+		uint32_t base;
+		uint16_t sequence;
+		uint16_t checksum;
+	};
+
+	/** @brief Slot state: new base written, region not yet erased
+	 */
+	static const uint8_t SLOT_PENDING = 0x5A;
+
+	/** @brief Slot state: region erased, increments count from this base
+	 */
+	static const uint8_t SLOT_COMMITTED = 0xA5;
+
+	/** @brief EEPROM bytes per slot, including the state byte
+	 */
+	static const size_t SLOT_SIZE = sizeof(BaseSlot) + 1;
+
+	/** @brief Address of the first base slot
+	 */
+	size_t _adr_base;
+
+	/** @brief Address of the unary region
+	 */
+	size_t _adr_region;
+
+	/** @brief Size of the unary region (bytes)
+	 */
+	size_t _regionSize;
+
+	/** @brief Count rolled up from previous regions
+	 */
+	uint32_t _base = 0;
+
+	/** @brief Number of cleared bits in the region
+	 */
+	uint32_t _position = 0;
+
+	/** @brief Slot holding the current base (0 or 1)
+	 */
+	uint8_t _slot = 1;
+
+	/** @brief Sequence number of the current base slot
+	 */
+	uint16_t _sequence = 0;
+
+	/**
+	 * @brief Store a new base value in the other slot and erase the region
+	 * 
+	 * @param value new base
+	 */
+	void _rollUp(uint32_t value);
+
+	/**
+	 * @brief Erase the region and mark the current slot committed
+	 */
+	void _eraseRegion();
+
+	/**
+	 * @brief Read a base slot
+	 * 
+	 * @param index slot (0 or 1)
+	 * @param slot slot contents
+	 * @return true Checksum valid
+	 * @return false Slot invalid
+	 */
+	bool _readSlot(uint8_t index, BaseSlot &slot);
+
+	/**
+	 * @brief Checksum of a base slot
+	 * 
+	 * @return uint16_t calculated checksum
+	 */
+	static uint16_t _calcChecksum(const BaseSlot &slot);
+};
@@ -0,0 +1,200 @@
+/**
+ * @file EEPROM_Endurance.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief EEPROM Lifetime Projection
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Write workload of one object on one device
+ */
+struct EEPROM_Workload
+{
+	/** Commits (object writes) per day */
+	double commitsPerDay;
+	/** EEPROM records written per commit, including the checksum */
+	double recordsPerCommit;
+	/** Number of locations the hottest record rotates over: 1 for a fixed address, the capacity for a ring log */
+	uint32_t spread;
+	/** Writes of the most-written cell per commit, at one location */
+	double hottestWritesPerCommit;
+	/** EEPROM bytes of one location (the image size) */
+	uint32_t footprint;
+};
+
+/**
+ * @brief EEPROM lifetime projection
+ * 
+ * Projects the years to first wear-out for a workload, so that storage strategies (full rewrite, sparse/delta
+ * overlay, wear-leveled ring log or counter) can be compared on the same settings-change rate. Two media models are
+ * supported:
+ * 	- Byte EEPROM: each record is a cell with its own endurance. The hottest cell is written
+ * 	  hottestWritesPerCommit times per commit (the checksum, for an EEPROM_Class image), or if more, the
+ * 	  average recordsPerCommit / footprint; divided by the spread.
+ * 	- Flash emulated EEPROM: records are appended to a set of flash pages, and a page is erased (after copying the
+ * 	  live records) each time the pages fill. Endurance is then set by the total records written per day.
+ * 
+ * Workloads can be measured on a device with measure(), from the EEPROM_Class write counters over a known period,
+ * and collected from a fleet to project the distribution of time to first failure with percentile().
+ * 
+ * Every projection is for a device whose cells all have exactly the rated endurance; it is not a fleet median,
+ * and percentile() spreads only the workloads. Real cells vary, and the first of the cells written to wear out
+ * fails the device, so the median of a fleet falls well below the projection, the more so the more cells share
+ * the writes (e.g. a ring log, where the gap can exceed an order of magnitude). The host tool
+ * host/tools/endurance.cpp prints the projection next to a simulation of the real classes with per-cell wear and
+ * random cell endurance, to show this gap; it does not validate the projection.
+ * 
+ * This header has no Particle dependencies so that the same projection can run in host tools.
+ * 
+ * @code
+ *     EEPROM_Endurance flash(10000, 16384, 2, 4, 2047);
+ *     EEPROM_Workload workload = EEPROM_Endurance::measure(mySettings, Time.now() - startTime);
+ *     Log.info("Projected life: %.1f years", flash.years(workload));
+ * @endcode
+ */
+class EEPROM_Endurance
+{
+public:
+	/**
+	 * @brief Byte EEPROM model
+	 * 
+	 * @param cellEndurance Rated write/erase cycles per cell
+	 */
+	EEPROM_Endurance(uint32_t cellEndurance) : _cellEndurance(cellEndurance), _pageSize(0), _pages(0), _flashBytesPerRecord(0), _liveRecords(0) {}
+
+	/**
+	 * @brief Flash emulated EEPROM model
+	 * 
+	 * @param cellEndurance Rated erase cycles per flash page
+	 * @param pageSize Flash page size (bytes)
+	 * @param pages Number of pages used by the emulation
+	 * @param flashBytesPerRecord Flash bytes used by one record, including its header
+	 * @param liveRecords Records copied to the new page on each erase (the emulated EEPROM size)
+	 */
+	EEPROM_Endurance(uint32_t cellEndurance, uint32_t pageSize, uint32_t pages, uint32_t flashBytesPerRecord, uint32_t liveRecords)
+		: _cellEndurance(cellEndurance), _pageSize(pageSize), _pages(pages), _flashBytesPerRecord(flashBytesPerRecord), _liveRecords(liveRecords) {}
+
+	/**
+	 * @brief Measure the workload of an object from its write counters
+	 * 
+	 * @tparam E EEPROM_Class type
+	 * @param object Object, with counters accumulated since resetCounters() or startup
+	 * @param elapsedSeconds Time over which the counters were accumulated
+	 * @param spread Locations the hottest record rotates over
+	 * @return EEPROM_Workload measured workload
+	 */
+	template <class E>
+	static EEPROM_Workload measure(E &object, uint32_t elapsedSeconds, uint32_t spread = 1)
+	{
+		EEPROM_Workload workload;
+		uint32_t commits = object.getWriteCount();
+
+		workload.commitsPerDay = elapsedSeconds ? commits * 86400.0 / elapsedSeconds : 0;
+		workload.recordsPerCommit = commits ? (double)object.getRecordsWritten() / commits : 0;
+		workload.spread = spread;
+		workload.hottestWritesPerCommit = E::CHECKSUM_WRITES;
+		workload.footprint = object.getSize();
+		return workload;
+	}
+
+	/**
+	 * @brief Project the years to first wear-out
+	 * 
+	 * @param workload Workload
+	 * @return double years, 0 if the model is invalid, a very large value for an idle workload
+	 */
+	double years(const EEPROM_Workload &workload) const
+	{
+		double wearPerDay;
+
+		if (_pageSize == 0)
+		{
+			// Byte EEPROM: hottest cell, at least the average cell of the footprint
+			double writesPerCommit = workload.hottestWritesPerCommit;
+
+			if ((workload.footprint != 0) && (workload.recordsPerCommit / workload.footprint > writesPerCommit))
+			{
+				writesPerCommit = workload.recordsPerCommit / workload.footprint;
+			}
+			wearPerDay = workload.commitsPerDay * writesPerCommit / (workload.spread ? workload.spread : 1);
+		}
+		else
+		{
+			// Flash emulation: erases of each page per day
+			double capacity = (double)_pageSize * _pages - (double)_liveRecords * _flashBytesPerRecord;
+
+			if (capacity <= 0)
+			{
+				return 0;
+			}
+			wearPerDay = workload.commitsPerDay * workload.recordsPerCommit * _flashBytesPerRecord / capacity;
+		}
+
+		if (wearPerDay <= 0)
+		{
+			return 1e9;
+		}
+		return _cellEndurance / wearPerDay / 365.25;
+	}
+
+	/**
+	 * @brief Project the fleet time to first failure at a percentile
+	 * 
+	 * @param fleet Workload of each device
+	 * @param results Work buffer, count entries; returned sorted with each device's projection
+	 * @param count Number of devices
+	 * @param percent Percentage of the fleet failed, e.g. 1 for the time when 1% of devices have worn out
+	 * @return double years
+	 */
+	double percentile(const EEPROM_Workload *fleet, double *results, size_t count, uint8_t percent) const
+	{
+		if (count == 0)
+		{
+			return 0;
+		}
+
+		// Insertion sort: fleets sampled on a device are small
+		for (size_t i = 0; i < count; i++)
+		{
+			double value = years(fleet[i]);
+			size_t j = i;
+
+			for (; (j > 0) && (results[j - 1] > value); j--)
+			{
+				results[j] = results[j - 1];
+			}
+			results[j] = value;
+		}
+
+		size_t index = (size_t)(percent * (count - 1) / 100.0 + 0.5);
+		return results[(index < count) ? index : count - 1];
+	}
+
+private:
+	/** @brief Rated cycles per cell or page
+	 */
+	uint32_t _cellEndurance;
+
+	/** @brief Flash page size, 0 for byte EEPROM
+	 */
+	uint32_t _pageSize;
+
+	/** @brief Number of flash pages
+	 */
+	uint32_t _pages;
+
+	/** @brief Flash bytes per record
+	 */
+	uint32_t _flashBytesPerRecord;
+
+	/** @brief Records copied on each erase
+	 */
+	uint32_t _liveRecords;
+};
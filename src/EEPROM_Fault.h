@@ -0,0 +1,197 @@
+/**
+ * @file EEPROM_Fault.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief EEPROM Power-Loss Fault Injection
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#pragma once
+#include <Particle.h>
+
+/**
+ * @brief Power-loss fault injection for EEPROM_Class writes
+ * 
+ * When EEPROM_FAULT_INJECTION is defined for the whole build (e.g. EXTRA_CFLAGS=-DEEPROM_FAULT_INJECTION), EEPROM_Class
+ * writes its object image and checksum one byte at a time through EEPROM_Fault. Once armed, EEPROM_Fault counts the
+ * byte writes and "cuts power" (by default System.reset()) immediately before the selected byte, leaving EEPROM exactly
+ * as a brownout at that point would. Stepping the cut through every byte index of an update, and checking what
+ * begin() loads after each reboot, exercises every partial-write state. See the powerLossTest example.
+ * 
+ * When EEPROM_FAULT_INJECTION is not defined, EEPROM_Class uses EEPROM.put() and EEPROM.write() directly.
+ * 
+ * @code
+ *     EEPROM_Fault::arm(cut);          // Reset before the cut'th byte write
+ *     mySettings.setTimeZone(-8);
+ *     EEPROM_Fault::disarm();          // Reached only if the update needed no more than cut bytes
+ * @endcode
+ */
+class EEPROM_Fault
+{
+public:
+	/** @brief Power cut handler
+	 */
+	typedef void (*Handler)();
+
+	/**
+	 * @brief Cut power before a future byte write
+	 * 
+	 * Once the cut has happened, every later write is dropped until the next arm() or disarm(), as with real
+	 * power loss, so that a handler that returns (e.g. in a host test) cannot complete the update.
+	 * 
+	 * @param bytes Number of byte writes to allow before the cut
+	 * @param handler Power cut handler, System.reset() by default
+	 */
+	static void arm(uint32_t bytes, Handler handler = NULL)
+	{
+		_state().countdown = bytes;
+		_state().written = 0;
+		_state().handler = handler;
+		_state().armed = true;
+		_state().fired = false;
+	}
+
+	/**
+	 * @brief Cancel a pending cut, or restore power after one
+	 * 
+	 */
+	static void disarm()
+	{
+		_state().armed = false;
+		_state().fired = false;
+	}
+
+	/**
+	 * @brief Check for a pending cut
+	 * 
+	 * @return true Cut pending
+	 * @return false Not armed
+	 */
+	static bool isArmed() { return _state().armed; }
+
+	/**
+	 * @brief Get the number of byte writes since arm()
+	 * 
+	 * @return uint32_t byte writes
+	 */
+	static uint32_t getBytesWritten() { return _state().written; }
+
+	/**
+	 * @brief Check whether the cut has happened since arm()
+	 * 
+	 * @return true Power cut, writes are being dropped
+	 * @return false No cut
+	 */
+	static bool hasFired() { return _state().fired; }
+
+	/**
+	 * @brief Write one byte, cutting power first if the countdown has run out
+	 * 
+	 * @param address EEPROM address
+	 * @param value Byte value
+	 */
+	static void write(int address, uint8_t value)
+	{
+		if (_state().fired)
+		{
+			return;
+		}
+		if (_state().armed)
+		{
+			if (_state().countdown == 0)
+			{
+				_state().armed = false;
+				_state().fired = true;
+				if (_state().handler != NULL)
+				{
+					_state().handler();
+				}
+				else
+				{
+					System.reset();
+				}
+				return;
+			}
+			_state().countdown--;
+		}
+		_state().written++;
+		EEPROM.write(address, value);
+	}
+
+	/**
+	 * @brief Write an object one byte at a time, as EEPROM.put() would
+	 * 
+	 * @param address EEPROM address
+	 * @param value Object
+	 * @return const T& the object
+	 */
+	template <class T>
+	static const T &put(int address, const T &value)
+	{
+		const uint8_t *data = reinterpret_cast<const uint8_t *>(&value);
+
+		for (size_t i = 0; i < sizeof(T); i++)
+		{
+			write(address + i, data[i]);
+		}
+		return value;
+	}
+
+	/**
+	 * @brief Write a block one byte at a time, as HAL_EEPROM_Put() would
+	 * 
+	 * @param address EEPROM address
+	 * @param data Block
+	 * @param length Number of bytes
+	 */
+	static void putBlock(int address, const void *data, size_t length)
+	{
+		const uint8_t *bytes = static_cast<const uint8_t *>(data);
+
+		for (size_t i = 0; i < length; i++)
+		{
+			write(address + i, bytes[i]);
+		}
+	}
+
+private:
+	/** @brief Injection state
+	 */
+	struct State
+	{
+		/** Byte writes left before the cut */
+		uint32_t countdown;
+		/** Byte writes since arm() */
+		uint32_t written;
+		/** Power cut handler, NULL for System.reset() */
+		Handler handler;
+		/** Cut pending */
+		bool armed;
+		/** Cut happened: writes dropped */
+		bool fired;
+	};
+
+	/**
+	 * @brief Injection state storage
+	 */
+	static State &_state()
+	{
+		static State state = {0, 0, NULL, false, false};
+		return state;
+	}
+};
+
+#ifdef EEPROM_FAULT_INJECTION
+//! @brief EEPROM.put() through the fault injector
+#define EEPROM_PUT(address, value) EEPROM_Fault::put(address, value)
+//! @brief EEPROM.write() through the fault injector
+#define EEPROM_WRITE(address, value) EEPROM_Fault::write(address, value)
+//! @brief HAL_EEPROM_Put() through the fault injector
+#define EEPROM_PUT_BLOCK(address, data, length) EEPROM_Fault::putBlock(address, data, length)
+#else
+#define EEPROM_PUT(address, value) EEPROM.put(address, value)
+#define EEPROM_WRITE(address, value) EEPROM.write(address, value)
+#define EEPROM_PUT_BLOCK(address, data, length) HAL_EEPROM_Put(address, data, length)
+#endif
@@ -0,0 +1,228 @@
+/**
+ * @file EEPROM_Fields.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Declarative Data Object Field Descriptions
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+
+#include <Particle.h>
+#include "EEPROM_Fields.h"
+
+const EEPROM_Field *EEPROM_Fields::find(const EEPROM_Field *fields, size_t count, size_t offset)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		if (fields[i].offset == offset)
+		{
+			return &fields[i];
+		}
+	}
+	return NULL;
+}
+
+bool EEPROM_Fields::validate(const EEPROM_Field &field, const void *value)
+{
+	switch (field.type)
+	{
+	case FIELD_FLOAT:
+	{
+		float temp;
+		memcpy(&temp, value, sizeof(temp));
+		// Written so that NaN is rejected
+		return (temp >= field.minValue) && (temp <= field.maxValue);
+	}
+
+	case FIELD_STRING:
+		return strnlen(static_cast<const char *>(value), field.size) < field.size;
+
+	case FIELD_ENUM:
+		for (size_t i = 0; i < field.nameCount; i++)
+		{
+			if (field.names[i].value == _enumValue(field, value))
+			{
+				return true;
+			}
+		}
+		return false;
+
+	default:
+		return true;
+	}
+}
+
+bool EEPROM_Fields::parse(const EEPROM_Field &field, const char *text, void *object)
+{
+	uint8_t *value = static_cast<uint8_t *>(object) + field.offset;
+	char *end;
+
+	switch (field.type)
+	{
+	case FIELD_BOOL:
+		if (!strcasecmp(text, "1") || !strcasecmp(text, "yes") || !strcasecmp(text, "true"))
+		{
+			*value = true;
+			return true;
+		}
+		if (!strcasecmp(text, "0") || !strcasecmp(text, "no") || !strcasecmp(text, "false"))
+		{
+			*value = false;
+			return true;
+		}
+		return false;
+
+	case FIELD_FLOAT:
+	{
+		float temp = strtof(text, &end);
+
+		if ((end == text) || (*end != 0) || !validate(field, &temp))
+		{
+			return false;
+		}
+		memcpy(value, &temp, sizeof(temp));
+		return true;
+	}
+
+	case FIELD_STRING:
+	{
+		size_t length = strnlen(text, field.size);
+
+		if (length >= field.size)
+		{
+			return false;
+		}
+		memset(value, 0, field.size);
+		memcpy(value, text, length);
+		return true;
+	}
+
+	case FIELD_ENUM:
+	{
+		uint8_t temp[sizeof(int32_t)];
+		long number = strtol(text, &end, 0);
+
+		for (size_t i = 0; i < field.nameCount; i++)
+		{
+			if (!strcasecmp(text, field.names[i].name))
+			{
+				number = field.names[i].value;
+				end = (char *)text + strlen(text);
+			}
+		}
+		if ((end == text) || (*end != 0) || (field.size > sizeof(temp)))
+		{
+			return false;
+		}
+		_setEnumValue(field, (int)number, temp);
+		if (!validate(field, temp))
+		{
+			return false;
+		}
+		memcpy(value, temp, field.size);
+		return true;
+	}
+
+	default:
+		return false;
+	}
+}
+
+const char *EEPROM_Fields::enumName(const EEPROM_Field &field, const void *value)
+{
+	for (size_t i = 0; i < field.nameCount; i++)
+	{
+		if (field.names[i].value == _enumValue(field, value))
+		{
+			return field.names[i].name;
+		}
+	}
+	return "Unknown";
+}
+
+void EEPROM_Fields::log(LogLevel level, const EEPROM_Field *fields, size_t count, const void *object)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		const EEPROM_Field &field = fields[i];
+		const uint8_t *value = static_cast<const uint8_t *>(object) + field.offset;
+
+		switch (field.type)
+		{
+		case FIELD_BOOL:
+			Log.log(level, "%s: %s", field.label, (*value) ? "Yes" : "No");
+			break;
+
+		case FIELD_FLOAT:
+		{
+			float temp;
+			char text[24];
+
+			memcpy(&temp, value, sizeof(temp));
+			snprintf(text, sizeof(text), (field.format != NULL) ? field.format : "%0.2f", temp);
+			Log.log(level, "%s: %s", field.label, text);
+			break;
+		}
+
+		case FIELD_STRING:
+			Log.log(level, "%s: %s", field.label, (const char *)value);
+			break;
+
+		case FIELD_ENUM:
+			Log.log(level, "%s: %s", field.label, enumName(field, value));
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
+int EEPROM_Fields::_enumValue(const EEPROM_Field &field, const void *value)
+{
+	switch (field.size)
+	{
+	case sizeof(int8_t):
+		return *static_cast<const int8_t *>(value);
+
+	case sizeof(int16_t):
+	{
+		int16_t temp;
+		memcpy(&temp, value, sizeof(temp));
+		return temp;
+	}
+
+	default:
+	{
+		int32_t temp;
+		memcpy(&temp, value, sizeof(temp));
+		return temp;
+	}
+	}
+}
+
+void EEPROM_Fields::_setEnumValue(const EEPROM_Field &field, int number, void *value)
+{
+	switch (field.size)
+	{
+	case sizeof(int8_t):
+		*static_cast<int8_t *>(value) = number;
+		break;
+
+	case sizeof(int16_t):
+	{
+		int16_t temp = number;
+		memcpy(value, &temp, sizeof(temp));
+		break;
+	}
+
+	default:
+	{
+		int32_t temp = number;
+		memcpy(value, &temp, sizeof(temp));
+		break;
+	}
+	}
+}
@@ -0,0 +1,157 @@
+/**
+ * @file EEPROM_Fields.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Declarative Data Object Field Descriptions
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#pragma once
+#include <Particle.h>
+#include <stddef.h>
+
+/**
+ * @brief Field types
+ */
+enum EEPROM_FieldType
+{
+	FIELD_BOOL,		//!< bool, logged as Yes/No
+	FIELD_FLOAT,	//!< float, validated against a range
+	FIELD_STRING,	//!< null-terminated char array
+	FIELD_ENUM		//!< enumeration, validated and logged using a name table
+};
+
+/**
+ * @brief Name of an enumeration value
+ */
+struct EEPROM_EnumName
+{
+	/** Enumeration value */
+	int value;
+	/** Display name */
+	const char *name;
+};
+
+/**
+ * @brief Description of one field of a data object
+ * 
+ * A table of these, declared once per data object with the EEPROM_FIELD_xxx macros, drives validation and
+ * logging of every field. Fields are logged as "label: value", floats with two decimals unless a format is
+ * given (EEPROM_FIELD_FLOAT_FORMAT()). UserSettingsClass
+ * generates its table, with the members and accessors, from USER_SETTINGS().
+ * 
+ * @code
+ *     static const EEPROM_EnumName modeNames[] = {{MODE_A, "A"}, {MODE_B, "B"}};
+ *     static const EEPROM_Field myFields[] = {
+ *         EEPROM_FIELD_FLOAT(MyObject, gain, "Gain", 0.0, 10.0),
+ *         EEPROM_FIELD_ENUM(MyObject, mode, "Mode", modeNames),
+ *     };
+ * @endcode
+ */
+struct EEPROM_Field
+{
+	/** Member name, used in warnings */
+	const char *name;
+	/** Display name, used in the log (plain text, not a format) */
+	const char *label;
+	/** Offset within the object */
+	uint16_t offset;
+	/** Size (bytes) */
+	uint16_t size;
+	/** EEPROM_FieldType */
+	uint8_t type;
+	/** FIELD_FLOAT minimum */
+	float minValue;
+	/** FIELD_FLOAT maximum */
+	float maxValue;
+	/** FIELD_ENUM name table */
+	const EEPROM_EnumName *names;
+	/** FIELD_ENUM number of names */
+	uint8_t nameCount;
+	/** FIELD_FLOAT printf format of the logged value, NULL for "%0.2f" */
+	const char *format;
+};
+
+//! @brief Describe a bool field
+#define EEPROM_FIELD_BOOL(OBJ, member, label) {#member, label, offsetof(OBJ, member), sizeof(((OBJ *)0)->member), FIELD_BOOL, 0, 0, NULL, 0, NULL}
+//! @brief Describe a float field with its valid range
+#define EEPROM_FIELD_FLOAT(OBJ, member, label, minValue, maxValue) {#member, label, offsetof(OBJ, member), sizeof(((OBJ *)0)->member), FIELD_FLOAT, minValue, maxValue, NULL, 0, NULL}
+//! @brief Describe a float field with its valid range and the printf format of its logged value
+#define EEPROM_FIELD_FLOAT_FORMAT(OBJ, member, label, format, minValue, maxValue) {#member, label, offsetof(OBJ, member), sizeof(((OBJ *)0)->member), FIELD_FLOAT, minValue, maxValue, NULL, 0, format}
+//! @brief Describe a null-terminated char array field
+#define EEPROM_FIELD_STRING(OBJ, member, label) {#member, label, offsetof(OBJ, member), sizeof(((OBJ *)0)->member), FIELD_STRING, 0, 0, NULL, 0, NULL}
+//! @brief Describe an enumeration field with its table of valid values
+#define EEPROM_FIELD_ENUM(OBJ, member, label, names) {#member, label, offsetof(OBJ, member), sizeof(((OBJ *)0)->member), FIELD_ENUM, 0, 0, names, sizeof(names) / sizeof(names[0]), NULL}
+
+/**
+ * @brief Field table operations
+ */
+struct EEPROM_Fields
+{
+	/**
+	 * @brief Find the field at an offset
+	 * 
+	 * @param fields Field table
+	 * @param count Number of fields
+	 * @param offset Offset within the object
+	 * @return const EEPROM_Field* field, NULL if none
+	 */
+	static const EEPROM_Field *find(const EEPROM_Field *fields, size_t count, size_t offset);
+
+	/**
+	 * @brief Check a new value for a field
+	 * 
+	 * @param field Field description
+	 * @param value New value, in the field's type
+	 * @return true Value valid
+	 * @return false Value out of range
+	 */
+	static bool validate(const EEPROM_Field &field, const void *value);
+
+	/**
+	 * @brief Set a field of an object from text, e.g. from a provisioning file or a cloud function argument
+	 * 
+	 * Booleans are "1", "0", "yes", "no", "true" or "false", floats are decimal, strings are taken as they
+	 * are (they must fit with their terminating null) and enumerations are a display name from the name table
+	 * or the numeric value. Case is ignored.
+	 * 
+	 * @param field Field description
+	 * @param text Value as text
+	 * @param object Object to receive the value
+	 * @return true Field set
+	 * @return false Text invalid or value out of range, field unchanged
+	 */
+	static bool parse(const EEPROM_Field &field, const char *text, void *object);
+
+	/**
+	 * @brief Get the display name of an enumeration field value
+	 * 
+	 * @param field Field description
+	 * @param value Field value
+	 * @return const char* name, "Unknown" if not in the table
+	 */
+	static const char *enumName(const EEPROM_Field &field, const void *value);
+
+	/**
+	 * @brief Log every field of an object
+	 * 
+	 * @param level Log level
+	 * @param fields Field table
+	 * @param count Number of fields
+	 * @param object Object to log
+	 */
+	static void log(LogLevel level, const EEPROM_Field *fields, size_t count, const void *object);
+
+private:
+	/**
+	 * @brief Read an enumeration value of the field's size
+	 */
+	static int _enumValue(const EEPROM_Field &field, const void *value);
+
+	/**
+	 * @brief Store an enumeration value in the field's size
+	 */
+	static void _setEnumValue(const EEPROM_Field &field, int number, void *value);
+};
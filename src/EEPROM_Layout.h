@@ -0,0 +1,56 @@
+/**
+ * @file EEPROM_Layout.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief EEPROM Image Layout Policies
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#pragma once
+#include <stddef.h>
+
+/**
+ * @brief Default layout policy
+ * 
+ * Images are packed byte-for-byte with no alignment or padding (original EEPROM_Class layout).
+ */
+struct EEPROM_DefaultLayout
+{
+	//! @brief Emulation record size (bytes)
+	static const size_t RECORD_SIZE = 1;
+
+	/**
+	 * @brief Round a size or address up to the next record boundary
+	 * 
+	 * @param value size or address
+	 * @return size_t aligned value
+	 */
+	static size_t align(size_t value) { return value; }
+};
+
+/**
+ * @brief Record-aligned layout policy for flash-emulated EEPROM
+ * 
+ * On devices where EEPROM is emulated in flash, a write that straddles a record boundary costs
+ * an extra record and brings the next page compaction closer. With this policy each image starts
+ * on a record boundary (an unaligned address is rounded up) and its size is rounded up to a whole
+ * number of records, so that objects placed back-to-back using getSize() never share a record.
+ * 
+ * @tparam RECORD Emulation record size in bytes (power of 2)
+ */
+template <size_t RECORD>
+struct EEPROM_RecordLayout
+{
+	//! @brief Emulation record size (bytes)
+	static const size_t RECORD_SIZE = RECORD;
+
+	/**
+	 * @brief Round a size or address up to the next record boundary
+	 * 
+	 * @param value size or address
+	 * @return size_t aligned value
+	 */
+	static size_t align(size_t value) { return (value + RECORD - 1) & ~(RECORD - 1); }
+};
@@ -0,0 +1,22 @@
+/**
+ * @file EEPROM_Object.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Common interface for EEPROM_Class instances
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+
+#include <Particle.h>
+#include "EEPROM_Object.h"
+#include "EEPROM_CommitGroup.h"
+
+EEPROM_Object::~EEPROM_Object()
+{
+	if (_group != NULL)
+	{
+		_group->_remove(*this);
+	}
+}
@@ -0,0 +1,149 @@
+/**
+ * @file EEPROM_Object.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Common interface for EEPROM_Class instances
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#pragma once
+#include <Particle.h>
+
+class EEPROM_CommitGroup;
+class EEPROM_BootLoader;
+
+/**
+ * @brief EEPROM Object Interface
+ * 
+ * Type-independent view of an EEPROM_Class instance, so that instances holding different object
+ * types can be managed together (see EEPROM_CommitGroup and EEPROM_BootLoader).
+ */
+class EEPROM_Object
+{
+public:
+	/**
+	 * @brief Destroy the eeprom object, removing it from its commit group
+	 * 
+	 */
+	virtual ~EEPROM_Object();
+
+	/**
+	 * @brief Write a deferred object update to EEPROM, if one is pending
+	 * 
+	 */
+	virtual void commitPending() = 0;
+
+	/**
+	 * @brief Get the checksum of the EEPROM object image
+	 * 
+	 * @return uint16_t stored checksum
+	 */
+	virtual uint16_t getChecksum() = 0;
+
+	/**
+	 * @brief Get the EEPROM address of the object
+	 * 
+	 * @return uint16_t address
+	 */
+	virtual uint16_t getAddress() = 0;
+
+	/**
+	 * @brief Get the Size of the object in EEPROM
+	 * 
+	 * @return size_t object size
+	 */
+	virtual size_t getSize() = 0;
+
+	/**
+	 * @brief Verify the object's EEPROM image from a RAM copy and load the object from it
+	 * 
+	 * @param image Copy of the getSize() bytes of EEPROM at getAddress()
+	 * @return true Object loaded
+	 * @return false Image invalid, object not loaded
+	 */
+	virtual bool loadImage(const uint8_t *image) = 0;
+
+	/**
+	 * @brief Verify the object's image and load the object directly from EEPROM
+	 * 
+	 * @return true Object loaded
+	 * @return false Image invalid, object not loaded
+	 */
+	virtual bool loadDirect() = 0;
+
+	/**
+	 * @brief Reset the object to its defaults and write it to EEPROM
+	 * 
+	 * @return true Defaults written
+	 * @return false Object has no defaults
+	 */
+	virtual bool loadDefaults() = 0;
+
+	/**
+	 * @brief Reset the object to its defaults and build its EEPROM image in RAM, for a batched write
+	 * 
+	 * The image's checksum is EEPROM_Checksum::TORN, so that a batch cut by power loss never passes. Once the
+	 * caller has written the image, sealDefaults() writes the real checksum.
+	 * 
+	 * @param image Buffer for the getSize() bytes of EEPROM at getAddress(); only the image bytes are set
+	 * @param offset Set to the offset in the buffer of the first image byte
+	 * @return size_t Offset in the buffer of the end of the image, 0 if not built (no defaults, in a commit
+	 * group or held by the wear budget)
+	 */
+	virtual size_t buildDefaults(uint8_t *image, size_t &offset) = 0;
+
+	/**
+	 * @brief Write the checksum of an image built by buildDefaults() and written by the caller
+	 * 
+	 */
+	virtual void sealDefaults() = 0;
+
+	/**
+	 * @brief Get the time spent loading the object by EEPROM_BootLoader
+	 * 
+	 * @return uint32_t microseconds
+	 */
+	uint32_t getBootMicros() { return _bootMicros; }
+
+	/**
+	 * @brief Check for a deferred object update
+	 * 
+	 * @return true Update waiting to be written
+	 * @return false EEPROM image is current
+	 */
+	bool isPending() { return _pending; }
+
+protected:
+	friend class EEPROM_CommitGroup;
+	friend class EEPROM_BootLoader;
+
+	/** @brief Commit group this object belongs to, NULL if written immediately
+	 */
+	EEPROM_CommitGroup *_group = NULL;
+
+	/** @brief Next member of the commit group
+	 */
+	EEPROM_Object *_nextMember = NULL;
+
+	/** @brief Object changed but not yet written to EEPROM
+	 */
+	bool _pending = false;
+
+	/** @brief Next object registered with the boot loader, in address order
+	 */
+	EEPROM_Object *_nextBoot = NULL;
+
+	/** @brief Time spent loading the object by the boot loader (microseconds)
+	 */
+	uint32_t _bootMicros = 0;
+
+	/** @brief Image valid at the last boot load
+	 */
+	bool _bootValid = false;
+
+	/** @brief Defaults image built for the boot loader's batched write
+	 */
+	bool _bootBatched = false;
+};
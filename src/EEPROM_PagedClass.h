@@ -0,0 +1,402 @@
+/**
+ * @file EEPROM_PagedClass.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Lazy-loading, page-granular EEPROM Class Header
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#pragma once
+#include <Particle.h>
+#include "EEPROM_Checksum.h"
+#include "EEPROM_Fault.h"
+
+/**
+ * @brief Paged EEPROM Class
+ *
+ * Variant of EEPROM_Class for large data objects (calibration tables, etc.) where most of the
+ * object is rarely read. Instead of copying the full object into RAM on startup, the EEPROM image
+ * is split into fixed-size pages, each protected by its own 16-bit checksum. Pages are loaded
+ * ("faulted in") on first access into a small LRU page cache, so startup time and resident RAM
+ * depend only on the pages actually touched.
+ *
+ * EEPROM layout at the assigned address:
+ * 	- Page checksum table, one uint16_t per page.
+ * 	- EEPROM image of the data object, split into pages of PAGE_SIZE bytes (last page may be short).
+ *
+ * Individual items are accessed with the typed get()/put() functions using the item's offset within
+ * the object, e.g.:
+ * @code
+ *     float gain;
+ *     myCalibration.get(offsetof(CalibrationObject, gain), gain);
+ * @endcode
+ *
+ * Writes are write-through: the cached page is updated, the changed bytes are written to EEPROM,
+ * and only the checksum of the affected page(s) is rewritten. As in EEPROM_Class, a page's checksum is set to
+ * EEPROM_Checksum::TORN before its bytes are rewritten and sealed after, so a page cut by power loss fails its
+ * checksum instead of loading a mix of old and new bytes; the other pages keep their data. All writes go through
+ * EEPROM_PUT()/EEPROM_WRITE(), so power-loss fault injection (EEPROM_Fault) covers this class too.
+ *
+ * @tparam OBJ Data object type
+ * @tparam PAGE_SIZE Page size in bytes
+ * @tparam CACHE_PAGES Number of pages held in RAM
+ */
+template <class OBJ, size_t PAGE_SIZE = 32, size_t CACHE_PAGES = 2>
+class EEPROM_PagedClass
+{
+public:
+	/** @brief Number of pages occupied by the data object
+	 */
+	static const size_t PAGE_COUNT = (sizeof(OBJ) + PAGE_SIZE - 1) / PAGE_SIZE;
+
+	/**
+	 * @brief Construct a new paged eeprom class object
+	 *
+	 */
+	EEPROM_PagedClass()
+	{
+		Log.trace("in EEPROM_PagedClass Constructor.");
+		_invalidateCache();
+	}
+
+	/**
+	 * @brief Destroy the paged eeprom class object
+	 *
+	 */
+	~EEPROM_PagedClass()
+	{
+		Log.trace("in EEPROM_PagedClass Destructor.");
+	}
+
+	/**
+	 * @brief Assign the EEPROM address of the object. No data is read until first access.
+	 *
+	 * @param address: EEPROM relative address for the saved object
+	 * @return true: Object fits in EEPROM
+	 * @return false: Object exceeds EEPROM size
+	 */
+	bool begin(uint16_t address)
+	{
+		_adr_checksum = address;
+		_adr_object = _adr_checksum + PAGE_COUNT * sizeof(uint16_t);
+		_eepromSize = sizeof(OBJ) + PAGE_COUNT * sizeof(uint16_t);
+		_invalidateCache();
+		Log.trace("_adr_checksum: %d, _adr_object: %d, _eepromSize: %d, pages: %d", _adr_checksum, _adr_object, _eepromSize, PAGE_COUNT);
+
+		if ((_adr_checksum + _eepromSize) > EEPROM.length())
+		{
+			Log.error("EEPROM paged object exceeds EEPROM size.");
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Write a complete object image and all page checksums to EEPROM
+	 *
+	 * Used to load defaults on first run or after a checksum error.
+	 *
+	 * @param object
+	 */
+	void initialize(const OBJ &object)
+	{
+		uint16_t torn = EEPROM_Checksum::TORN;
+
+		for (size_t page = 0; page < PAGE_COUNT; page++)
+		{
+			EEPROM_PUT(_adr_checksum + page * sizeof(uint16_t), torn);
+		}
+		EEPROM_PUT(_adr_object, object);
+		for (size_t page = 0; page < PAGE_COUNT; page++)
+		{
+			uint16_t checkSum = EEPROM_Checksum::seal(EEPROM_Checksum::calculate(reinterpret_cast<const uint8_t *>(&object) + page * PAGE_SIZE, _pageLength(page)));
+
+			EEPROM_PUT(_adr_checksum + page * sizeof(uint16_t), checkSum);
+		}
+		_invalidateCache();
+		Log.trace("EEPROM paged object initialized.");
+	}
+
+	/**
+	 * @brief Read a data item from the object
+	 *
+	 * @param offset Offset of the item within the object (use offsetof())
+	 * @param value Item to receive the data
+	 * @return true Item loaded
+	 * @return false Offset out of range or page checksum invalid
+	 */
+	template <class T>
+	bool get(size_t offset, T &value)
+	{
+		return read(offset, &value, sizeof(T));
+	}
+
+	/**
+	 * @brief Write a data item to the object
+	 *
+	 * @param offset Offset of the item within the object (use offsetof())
+	 * @param value New item value
+	 * @return true Item written
+	 * @return false Offset out of range or page checksum invalid
+	 */
+	template <class T>
+	bool put(size_t offset, const T &value)
+	{
+		return write(offset, &value, sizeof(T));
+	}
+
+	/**
+	 * @brief Read a range of bytes from the object
+	 *
+	 * @param offset Offset within the object
+	 * @param dest Destination buffer
+	 * @param length Number of bytes
+	 * @return true Data loaded
+	 * @return false Range invalid or page checksum invalid
+	 */
+	bool read(size_t offset, void *dest, size_t length)
+	{
+		uint8_t *out = static_cast<uint8_t *>(dest);
+
+		if ((offset + length) > sizeof(OBJ))
+		{
+			Log.error("EEPROM paged read out of range.");
+			return false;
+		}
+
+		while (length > 0)
+		{
+			size_t page = offset / PAGE_SIZE;
+			size_t start = offset % PAGE_SIZE;
+			size_t count = min(length, _pageLength(page) - start);
+			CachePage *cached = _fault(page);
+
+			if (cached == NULL)
+			{
+				return false;
+			}
+			memcpy(out, &cached->data[start], count);
+			out += count;
+			offset += count;
+			length -= count;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Write a range of bytes to the object
+	 *
+	 * Only the changed bytes and the checksums of the pages they are in are written to EEPROM.
+	 *
+	 * @param offset Offset within the object
+	 * @param src Source buffer
+	 * @param length Number of bytes
+	 * @return true Data written
+	 * @return false Range invalid or page checksum invalid
+	 */
+	bool write(size_t offset, const void *src, size_t length)
+	{
+		const uint8_t *in = static_cast<const uint8_t *>(src);
+
+		if ((offset + length) > sizeof(OBJ))
+		{
+			Log.error("EEPROM paged write out of range.");
+			return false;
+		}
+
+		while (length > 0)
+		{
+			size_t page = offset / PAGE_SIZE;
+			size_t start = offset % PAGE_SIZE;
+			size_t count = min(length, _pageLength(page) - start);
+			CachePage *cached = _fault(page);
+
+			if (cached == NULL)
+			{
+				return false;
+			}
+
+			if (memcmp(&cached->data[start], in, count) != 0)
+			{
+				uint16_t checkSum = EEPROM_Checksum::TORN;
+
+				EEPROM_PUT(_adr_checksum + page * sizeof(uint16_t), checkSum);
+				for (size_t i = 0; i < count; i++)
+				{
+					if (cached->data[start + i] != in[i])
+					{
+						cached->data[start + i] = in[i];
+						EEPROM_WRITE(_adr_object + offset + i, in[i]);
+					}
+				}
+				checkSum = EEPROM_Checksum::seal(EEPROM_Checksum::calculate(cached->data, _pageLength(page)));
+				EEPROM_PUT(_adr_checksum + page * sizeof(uint16_t), checkSum);
+			}
+
+			in += count;
+			offset += count;
+			length -= count;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Verify the checksums of all pages directly from EEPROM. Does not use the page cache.
+	 *
+	 * @return true All page checksums valid
+	 * @return false One or more pages invalid
+	 */
+	bool verifyChecksum()
+	{
+		for (size_t page = 0; page < PAGE_COUNT; page++)
+		{
+			if (!_verifyPage(page))
+			{
+				Log.error("EEPROM paged object page %d checksum invalid.", page);
+				return false;
+			}
+		}
+		Log.info("EEPROM paged object checksums valid.");
+		return true;
+	}
+
+	/**
+	 * @brief Get the Size of the object
+	 *
+	 * @return size_t object size, including page checksum table
+	 */
+	size_t getSize() { return _eepromSize; }
+
+protected:
+	/** @brief Address assigned to the data object in EEPROM.
+	 */
+	size_t _adr_object;
+
+	/** @brief Address assigned to the page checksum table in EEPROM.
+	 */
+	size_t _adr_checksum;
+
+	/** @brief Total memory size of the data object (bytes)
+	 */
+	size_t _eepromSize;
+
+private:
+	/** @brief Page cache entry
+	 */
+	struct CachePage
+	{
+		/** Page number held in this entry */
+		size_t page;
+		/** Access stamp for LRU replacement */
+		uint32_t lastUsed;
+		/** Entry holds a verified page */
+		bool valid;
+		/** Page data */
+		uint8_t data[PAGE_SIZE];
+	};
+
+	/** @brief Page cache
+	 */
+	CachePage _cache[CACHE_PAGES];
+
+	/** @brief Access counter used to stamp cache entries
+	 */
+	uint32_t _accessCount;
+
+	/**
+	 * @brief Mark all cache entries empty
+	 */
+	void _invalidateCache()
+	{
+		for (size_t i = 0; i < CACHE_PAGES; i++)
+		{
+			_cache[i].valid = false;
+			_cache[i].lastUsed = 0;
+		}
+		_accessCount = 0;
+	}
+
+	/**
+	 * @brief Return the cache entry for a page, loading and verifying it from EEPROM if needed
+	 *
+	 * @param page Page number
+	 * @return CachePage* cache entry, or NULL if the page checksum is invalid
+	 */
+	CachePage *_fault(size_t page)
+	{
+		CachePage *victim = &_cache[0];
+
+		for (size_t i = 0; i < CACHE_PAGES; i++)
+		{
+			if (_cache[i].valid && (_cache[i].page == page))
+			{
+				_cache[i].lastUsed = ++_accessCount;
+				return &_cache[i];
+			}
+			if (!_cache[i].valid)
+			{
+				victim = &_cache[i];
+			}
+			else if (victim->valid && (_cache[i].lastUsed < victim->lastUsed))
+			{
+				victim = &_cache[i];
+			}
+		}
+
+		uint16_t checkSum;
+		size_t length = _pageLength(page);
+
+		for (size_t i = 0; i < length; i++)
+		{
+			victim->data[i] = EEPROM.read(_adr_object + page * PAGE_SIZE + i);
+		}
+		EEPROM.get(_adr_checksum + page * sizeof(uint16_t), checkSum);
+
+		if (checkSum != EEPROM_Checksum::seal(EEPROM_Checksum::calculate(victim->data, length)))
+		{
+			victim->valid = false;
+			Log.error("EEPROM paged object page %d checksum invalid.", page);
+			return NULL;
+		}
+
+		victim->page = page;
+		victim->valid = true;
+		victim->lastUsed = ++_accessCount;
+		Log.trace("EEPROM paged object page %d loaded.", page);
+		return victim;
+	}
+
+	/**
+	 * @brief Verify one page checksum directly from EEPROM
+	 *
+	 * @param page Page number
+	 * @return true Checksum valid
+	 * @return false Checksum invalid
+	 */
+	bool _verifyPage(size_t page)
+	{
+		uint8_t data[PAGE_SIZE];
+		uint16_t checkSum;
+		size_t start = _adr_object + page * PAGE_SIZE;
+
+		for (size_t i = 0; i < _pageLength(page); i++)
+		{
+			data[i] = EEPROM.read(start + i);
+		}
+		EEPROM.get(_adr_checksum + page * sizeof(uint16_t), checkSum);
+		return checkSum == EEPROM_Checksum::seal(EEPROM_Checksum::calculate(data, _pageLength(page)));
+	}
+
+	/**
+	 * @brief Length of a page in bytes (the last page may be short)
+	 *
+	 * @param page Page number
+	 * @return size_t page length
+	 */
+	static size_t _pageLength(size_t page)
+	{
+		return (page == PAGE_COUNT - 1) ? sizeof(OBJ) - page * PAGE_SIZE : PAGE_SIZE;
+	}
+};
@@ -0,0 +1,299 @@
+/**
+ * @file EEPROM_Replay.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief EEPROM Operation Trace Replay
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#pragma once
+#include <Particle.h>
+#include "EEPROM_Class.h"
+#include "EEPROM_TraceFormat.h"
+
+/**
+ * @brief Trace replay
+ * 
+ * Drives the operation sequence of a binary trace (EEPROM_Trace::exportBinary(), e.g. captured in the field) against
+ * an EEPROM_Class object, or an object of a class derived from it such as UserSettingsClass, on the bench, and
+ * collects the recorded and replayed time and the EEPROM I/O for each operation type, so that a field workload
+ * (setter storms, boots after corruption) can be profiled and compared between library versions.
+ * 
+ * Only top-level operations are replayed (begin, readObject, verifyChecksum, cached or not, and writes); the spans
+ * nested inside them (verify within a read, put and checksum within a write) are reproduced by the library itself.
+ * A top-level put or checksum span (one recorded outside a write, e.g. by EEPROM_BootLoader::sealDefaults()) has
+ * no replayable counterpart, and is counted as skipped rather than replayed as a write.
+ * A target with its own begin(address), such as UserSettingsClass, is started through it, so that its full boot
+ * path (including reinitialization after an invalid image) is replayed. Reads and writes use the target's own
+ * working copy once it has one. The trace holds no object data, so each replayed write changes the first byte of
+ * the object to make sure it reaches the EEPROM.
+ * 
+ * The trace should come from a single object of type OBJ.
+ * 
+ * @code
+ *     EEPROM_Replay<SettingsObject> replay;
+ *     if (replay.load(trace, traceLength))
+ *     {
+ *         replay.run(myEEPROM, myObject);      // or replay.run(mySettings, scratch) for a UserSettingsClass
+ *         replay.report(Serial);
+ *     }
+ * @endcode
+ * 
+ * @tparam OBJ Data object type
+ * @tparam LAYOUT EEPROM layout policy of the target
+ */
+template <class OBJ, class LAYOUT = EEPROM_DefaultLayout>
+class EEPROM_Replay
+{
+public:
+	/** @brief Number of operation types
+	 */
+	static const size_t OP_COUNT = TRACE_VERIFY_CACHED + 1;
+
+	/** @brief Statistics for one operation type
+	 */
+	struct OpStats
+	{
+		/** Operations replayed */
+		uint32_t count;
+		/** Top-level operations not replayed (put or checksum outside a write) */
+		uint32_t skipped;
+		/** Recorded time (microseconds) */
+		uint32_t recordedMicros;
+		/** Replayed time (microseconds) */
+		uint32_t replayMicros;
+		/** EEPROM bytes read during replay */
+		uint32_t bytesRead;
+		/** EEPROM bytes written during replay */
+		uint32_t bytesWritten;
+	};
+
+	/**
+	 * @brief Construct a new replay object
+	 * 
+	 */
+	EEPROM_Replay() : _records(NULL), _count(0)
+	{
+		memset(_stats, 0, sizeof(_stats));
+	}
+
+	/**
+	 * @brief Validate and load a binary trace. The buffer must remain valid until run() returns.
+	 * 
+	 * @param buffer Trace
+	 * @param length Trace length
+	 * @return true Trace loaded
+	 * @return false Trace invalid
+	 */
+	bool load(const uint8_t *buffer, size_t length)
+	{
+		int count = EEPROM_TraceFormat::decodeHeader(buffer, length);
+
+		if (count < 0)
+		{
+			Log.error("EEPROM trace invalid.");
+			return false;
+		}
+		_records = &buffer[EEPROM_TraceFormat::HEADER_SIZE];
+		_count = count;
+		Log.trace("EEPROM trace loaded, %d records.", count);
+		return true;
+	}
+
+	/**
+	 * @brief Replay the trace
+	 * 
+	 * @tparam TARGET EEPROM_Class<OBJ, LAYOUT> or a class derived from it
+	 * @param target Object to drive
+	 * @param object Working copy of the data object, used until the target has its own
+	 * @param paced true to start each operation at its recorded time offset, false to replay back to back
+	 */
+	template <class TARGET>
+	void run(TARGET &target, OBJ &object, bool paced = false)
+	{
+		EEPROM_Class<OBJ, LAYOUT> &base = target;
+		EEPROM_TraceEvent first;
+		uint32_t replayStart = micros();
+
+		memset(_stats, 0, sizeof(_stats));
+		if (_count == 0)
+		{
+			return;
+		}
+		_event(0, first);
+
+		for (size_t i = 0; i < _count; i++)
+		{
+			EEPROM_TraceEvent event;
+
+			_event(i, event);
+			if ((event.op >= OP_COUNT) || _isNested(i, event))
+			{
+				continue;
+			}
+
+			while (paced && ((int32_t)((micros() - replayStart) - (event.start - first.start)) < 0))
+				;
+
+			OpStats &stats = _stats[event.op];
+
+			if ((event.op == TRACE_PUT) || (event.op == TRACE_CHECKSUM))
+			{
+				stats.skipped++;
+				continue;
+			}
+
+			OBJ &working = (base.getObject() != NULL) ? *base.getObject() : object;
+			uint32_t bytesRead = base.getBytesRead();
+			uint32_t bytesWritten = base.getBytesWritten();
+			uint32_t start = micros();
+
+			switch (event.op)
+			{
+			case TRACE_BEGIN:
+				_begin(target, event.address, object, 0);
+				break;
+
+			case TRACE_READ:
+				base.readObject(working);
+				break;
+
+			case TRACE_VERIFY:
+				base.verifyChecksum(true);
+				break;
+
+			case TRACE_VERIFY_CACHED:
+				base.verifyChecksum(false);
+				break;
+
+			case TRACE_WRITE:
+				reinterpret_cast<uint8_t *>(&working)[0]++;
+				base.writeObject(working);
+				break;
+			}
+
+			stats.replayMicros += micros() - start;
+			stats.recordedMicros += event.duration;
+			stats.bytesRead += base.getBytesRead() - bytesRead;
+			stats.bytesWritten += base.getBytesWritten() - bytesWritten;
+			stats.count++;
+		}
+	}
+
+	/**
+	 * @brief Get the statistics for an operation type
+	 * 
+	 * @param op Operation (EEPROM_TraceOp)
+	 * @return const OpStats& statistics
+	 */
+	const OpStats &getStats(EEPROM_TraceOp op) { return _stats[op]; }
+
+	/**
+	 * @brief Print the statistics of each replayed operation type as a JSON line
+	 * 
+	 * @param out Output stream, e.g. Serial
+	 */
+	void report(Print &out)
+	{
+		for (size_t op = 0; op < OP_COUNT; op++)
+		{
+			const OpStats &stats = _stats[op];
+
+			if ((stats.count > 0) || (stats.skipped > 0))
+			{
+				out.printlnf("{\"op\":\"%s\",\"count\":%lu,\"skipped\":%lu,\"recorded_us\":%lu,\"replay_us\":%lu,\"read_bytes\":%lu,\"write_bytes\":%lu}",
+							 EEPROM_TraceFormat::opName(op), (unsigned long)stats.count, (unsigned long)stats.skipped, (unsigned long)stats.recordedMicros, (unsigned long)stats.replayMicros,
+							 (unsigned long)stats.bytesRead, (unsigned long)stats.bytesWritten);
+			}
+		}
+	}
+
+private:
+	/** @brief Trace records
+	 */
+	const uint8_t *_records;
+
+	/** @brief Number of trace records
+	 */
+	size_t _count;
+
+	/** @brief Statistics for each operation type
+	 */
+	OpStats _stats[OP_COUNT];
+
+	/**
+	 * @brief Start a target that has its own begin(address), e.g. UserSettingsClass
+	 */
+	template <class TARGET>
+	static auto _begin(TARGET &target, uint16_t address, OBJ &object, int) -> decltype(target.begin(address))
+	{
+		(void)object;
+		return target.begin(address);
+	}
+
+	/**
+	 * @brief Start a plain EEPROM_Class target with the given working copy
+	 */
+	template <class TARGET>
+	static bool _begin(TARGET &target, uint16_t address, OBJ &object, long)
+	{
+		return target.begin(address, object);
+	}
+
+	/**
+	 * @brief Decode a trace record
+	 */
+	void _event(size_t index, EEPROM_TraceEvent &event)
+	{
+		EEPROM_TraceFormat::decodeRecord(&_records[index * EEPROM_TraceFormat::RECORD_SIZE], event);
+	}
+
+	/**
+	 * @brief Check whether a span is nested inside a later one
+	 * 
+	 * A span is recorded when it ends, so its enclosing span follows it, after at most a few sibling spans.
+	 * 
+	 * @param index Record index
+	 * @param event The record
+	 * @return true Nested, replayed by its enclosing operation
+	 * @return false Top-level operation
+	 */
+	bool _isNested(size_t index, const EEPROM_TraceEvent &event)
+	{
+		for (size_t j = index + 1; (j < _count) && (j <= index + 8); j++)
+		{
+			EEPROM_TraceEvent outer;
+
+			_event(j, outer);
+			if (_canEnclose(outer.op, event.op) && ((int32_t)(event.start - outer.start) >= 0) &&
+				((int32_t)((outer.start + outer.duration) - (event.start + event.duration)) >= 0))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Check whether an operation can contain another
+	 */
+	static bool _canEnclose(uint8_t outer, uint8_t inner)
+	{
+		switch (outer)
+		{
+		case TRACE_BEGIN:
+			return inner != TRACE_BEGIN;
+
+		case TRACE_READ:
+			return inner == TRACE_VERIFY;
+
+		case TRACE_WRITE:
+			return (inner == TRACE_PUT) || (inner == TRACE_CHECKSUM);
+
+		default:
+			return false;
+		}
+	}
+};
@@ -0,0 +1,359 @@
+/**
+ * @file EEPROM_RingLog.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Circular Record Log Class Header
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#pragma once
+#include <Particle.h>
+#include "EEPROM_Checksum.h"
+
+/**
+ * @brief Ring Log Class
+ * 
+ * Circular log of fixed-size records (e.g. sensor samples held between cloud syncs). Each record is stored
+ * in a slot together with a sequence number and its own checksum; when the log is full the oldest record is
+ * overwritten.
+ * 
+ * Appends are buffered in RAM and written in batches of BATCH records, either when the buffer fills or on
+ * flush(). Record n is always stored in slot n % capacity. On startup, begin() locates the newest record with a
+ * binary search over the sequence numbers, reading O(log n) slots, and then the oldest from the sequence
+ * numbers of the slots past the newest, so that a write torn by power loss costs only that record. If slot 0
+ * is invalid, begin() falls back to a full scan.
+ * 
+ * Records are read back oldest first with rewind() and readNext():
+ * @code
+ *     mySamples.rewind();
+ *     while (mySamples.readNext(sample))
+ *         // upload sample
+ * @endcode
+ * 
+ * @tparam REC Record type
+ * @tparam BATCH Number of records buffered in RAM before writing
+ */
+template <class REC, size_t BATCH = 4>
+class EEPROM_RingLog
+{
+public:
+	/**
+	 * @brief Construct a new ring log object
+	 * 
+	 * @param capacity Number of records held in EEPROM
+	 */
+	EEPROM_RingLog(size_t capacity)
+	{
+		_adr_log = 0;
+		_capacity = capacity;
+		_count = 0;
+		_head = 0;
+		_nextSequence = 0;
+		_readIndex = 0;
+		_buffered = 0;
+		Log.trace("in EEPROM_RingLog Constructor.");
+	}
+
+	/**
+	 * @brief Destroy the ring log object. Buffered records are not written.
+	 * 
+	 */
+	~EEPROM_RingLog()
+	{
+		Log.trace("in EEPROM_RingLog Destructor.");
+	}
+
+	/**
+	 * @brief Initialize the log and locate the newest and oldest records in EEPROM
+	 * 
+	 * @param address: EEPROM relative address for the log
+	 * @return true: Existing records found
+	 * @return false: Log empty
+	 */
+	bool begin(uint16_t address)
+	{
+		Slot slot;
+
+		_adr_log = address;
+		_buffered = 0;
+		_count = 0;
+		_head = 0;
+		_nextSequence = 0;
+
+		if (_readSlot(0, slot))
+		{
+			// Slots 0..newest hold consecutive sequence numbers, so the newest is found by binary search
+			uint32_t firstSequence = slot.sequence;
+			size_t low = 0;
+			size_t high = _capacity - 1;
+
+			while (low < high)
+			{
+				size_t mid = (low + high + 1) / 2;
+
+				if (_holds(mid, firstSequence + mid))
+				{
+					low = mid;
+				}
+				else
+				{
+					high = mid - 1;
+				}
+			}
+			_head = (low + 1) % _capacity;
+			_nextSequence = firstSequence + low + 1;
+			_count = low + 1;
+
+			// Wrapped: the previous lap continues in the slots past the newest, from the first one that holds its
+			// record (the slot at the head is invalid if its write was torn)
+			if (firstSequence >= _capacity)
+			{
+				for (size_t i = low + 1; i < _capacity; i++)
+				{
+					if (_holds(i, firstSequence - _capacity + i))
+					{
+						_count += _capacity - i;
+						break;
+					}
+				}
+			}
+		}
+		else
+		{
+			// Empty log, or slot 0 damaged: scan every slot for the newest record
+			bool found = false;
+
+			for (size_t i = 1; i < _capacity; i++)
+			{
+				if (_readSlot(i, slot) && ((slot.sequence % _capacity) == i) && (!found || (slot.sequence >= _nextSequence)))
+				{
+					found = true;
+					_head = (i + 1) % _capacity;
+					_nextSequence = slot.sequence + 1;
+				}
+			}
+
+			// The oldest record is the first valid one of the window of the last capacity records
+			for (size_t back = min((size_t)_nextSequence, _capacity); found && (back > 0); back--)
+			{
+				uint32_t sequence = _nextSequence - back;
+
+				if (_holds(sequence % _capacity, sequence))
+				{
+					_count = back;
+					break;
+				}
+			}
+		}
+
+		rewind();
+		Log.trace("_adr_log: %d, capacity: %d, records: %d, head: %d, next sequence: %lu", _adr_log, _capacity, _count, _head, (unsigned long)_nextSequence);
+		return _count > 0;
+	}
+
+	/**
+	 * @brief Append a record. The record is buffered and written with the next batch.
+	 * 
+	 * @param record 
+	 */
+	void append(const REC &record)
+	{
+		_buffer[_buffered++] = record;
+		if (_buffered == BATCH)
+		{
+			flush();
+		}
+	}
+
+	/**
+	 * @brief Write all buffered records to EEPROM
+	 * 
+	 * @return size_t number of records written
+	 */
+	size_t flush()
+	{
+		size_t written = _buffered;
+		Slot slot;
+
+		for (size_t i = 0; i < _buffered; i++)
+		{
+			memset(&slot, 0, sizeof(slot));
+			slot.sequence = _nextSequence++;
+			slot.record = _buffer[i];
+			slot.checksum = _calcChecksum(slot);
+			EEPROM.put(_adr_log + _head * sizeof(Slot), slot);
+
+			_head = (_head + 1) % _capacity;
+			if (_count < _capacity)
+			{
+				_count++;
+			}
+		}
+		_buffered = 0;
+
+		if (written > 0)
+		{
+			Log.trace("EEPROM ring log: %d records written, next sequence: %lu", written, (unsigned long)_nextSequence);
+		}
+		return written;
+	}
+
+	/**
+	 * @brief Position the read cursor at the oldest record in EEPROM
+	 * 
+	 */
+	void rewind()
+	{
+		_readIndex = 0;
+	}
+
+	/**
+	 * @brief Read the next valid record at or after the cursor and advance. Buffered records are not included;
+	 * call flush() first.
+	 * 
+	 * A slot damaged since its record was written is skipped (and logged).
+	 * 
+	 * @param record Record to receive the data
+	 * @param sequence Optional, receives the record sequence number
+	 * @return true Record read
+	 * @return false No more records
+	 */
+	bool readNext(REC &record, uint32_t *sequence = NULL)
+	{
+		Slot slot;
+
+		while (_readIndex < _count)
+		{
+			uint32_t expected = _nextSequence - _count + _readIndex;
+			size_t index = expected % _capacity;
+
+			_readIndex++;
+			if (!_readSlot(index, slot) || (slot.sequence != expected))
+			{
+				Log.error("EEPROM ring log record %d invalid.", index);
+				continue;
+			}
+
+			record = slot.record;
+			if (sequence != NULL)
+			{
+				*sequence = slot.sequence;
+			}
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Get the number of records stored in EEPROM, from the oldest to the newest
+	 * 
+	 * A record whose slot was damaged after a later record was written is still counted; readNext() skips it.
+	 * 
+	 * @return size_t record count
+	 */
+	size_t getCount() { return _count; }
+
+	/**
+	 * @brief Get the sequence number the next record will receive
+	 * 
+	 * @return uint32_t sequence number
+	 */
+	uint32_t getNextSequence() { return _nextSequence + _buffered; }
+
+	/**
+	 * @brief Get the Size of the log in EEPROM
+	 * 
+	 * @return size_t log size
+	 */
+	size_t getSize() { return _capacity * sizeof(Slot); }
+
+private:
+	/** @brief Record slot stored in EEPROM
+	 */
+	struct Slot
+	{
+		/** Sequence number, incremented for each record written */
+		uint32_t sequence;
+		/** Record data */
+		REC record;
+		/** Checksum of sequence and record */
+		uint16_t checksum;
+	};
+
+	/** @brief Address assigned to the log in EEPROM.
+	 */
+	size_t _adr_log;
+
+	/** @brief Number of slots
+	 */
+	size_t _capacity;
+
+	/** @brief Number of records in EEPROM, from the oldest valid record to the newest
+	 */
+	size_t _count;
+
+	/** @brief Slot the next record will be written to
+	 */
+	size_t _head;
+
+	/** @brief Sequence number of the next record written
+	 */
+	uint32_t _nextSequence;
+
+	/** @brief Read cursor, relative to the oldest record
+	 */
+	size_t _readIndex;
+
+	/** @brief Records waiting to be written
+	 */
+	REC _buffer[BATCH];
+
+	/** @brief Number of buffered records
+	 */
+	size_t _buffered;
+
+	/**
+	 * @brief Read a slot and verify its checksum
+	 * 
+	 * @param index Slot number
+	 * @param slot Slot to receive the data
+	 * @return true Slot valid
+	 * @return false Slot empty or checksum invalid
+	 */
+	bool _readSlot(size_t index, Slot &slot)
+	{
+		EEPROM.get(_adr_log + index * sizeof(Slot), slot);
+		return slot.checksum == _calcChecksum(slot);
+	}
+
+	/**
+	 * @brief Check that a slot is valid and holds a given record
+	 * 
+	 * @param index Slot number
+	 * @param sequence Sequence number of the record
+	 * @return true Slot holds the record
+	 * @return false Slot invalid, or holds another record
+	 */
+	bool _holds(size_t index, uint32_t sequence)
+	{
+		Slot slot;
+
+		return _readSlot(index, slot) && (slot.sequence == sequence);
+	}
+
+	/**
+	 * @brief Calculate the checksum of a slot
+	 * 
+	 * @return uint16_t calculated checksum
+	 */
+	static uint16_t _calcChecksum(const Slot &slot)
+	{
+		uint16_t temp = EEPROM_Checksum::calculate(&slot.sequence, sizeof(slot.sequence));
+
+		temp = EEPROM_Checksum::calculate(&slot.record, sizeof(slot.record), temp);
+		// Complement so that an erased (all 0xFF) slot is never valid
+		return ~temp;
+	}
+};
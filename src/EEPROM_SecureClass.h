@@ -0,0 +1,469 @@
+/**
+ * @file EEPROM_SecureClass.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief Encrypted, block-authenticated EEPROM Class Header
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2019
+ *
+ */
+#pragma once
+#include <Particle.h>
+#include "EEPROM_Cipher.h"
+#include "EEPROM_Fault.h"
+
+/**
+ * @brief Secure EEPROM Class
+ *
+ * Variant of EEPROM_Class for sensitive data objects (credentials, keys). The object is split into blocks of
+ * BLOCK_SIZE bytes, each stored encrypted with ChaCha20 and authenticated with a 64-bit SipHash tag, so that
+ * changing one item re-encrypts and rewrites only the blocks it touches. Blocks are decrypted and verified
+ * lazily, on first access.
+ *
+ * EEPROM layout at the assigned address, one slot per block:
+ * 	- Nonce, 12 bytes, drawn fresh from the hardware RNG each time the block is written.
+ * 	- Ciphertext, BLOCK_SIZE bytes (the last block is zero padded).
+ * 	- Tag, 8 bytes.
+ *
+ * Nothing read back from EEPROM is used to pick a nonce, so altering or erasing the stored data cannot make a
+ * nonce repeat for the same key. The tag covers the object address, block number, nonce and ciphertext, so a
+ * block that is corrupted, altered or moved is rejected, and tags are compared in constant time. Restoring an
+ * older valid copy of a block (rollback) is not detected.
+ *
+ * A power cut while a block is written leaves that one block failing authentication: readObject(), and any
+ * read or write touching the block, fail until the object is rewritten with initialize(). Items in the other
+ * blocks can still be read with get() first, to carry them over.
+ *
+ * Items are accessed with the typed get()/put() functions using the item's offset within the object, e.g.:
+ * @code
+ *     EEPROM_SecureClass<UserCredentials> myCredentials;
+ *     myCredentials.begin(objectAddress, deviceKey);
+ *     myCredentials.put(offsetof(UserCredentials, password), newPassword);
+ * @endcode
+ *
+ * @note The key must be kept outside EEPROM (e.g. derived from the device ID and a secret in flash).
+ *
+ * @tparam OBJ Data object type
+ * @tparam BLOCK_SIZE Block size in bytes (at most 64)
+ */
+template <class OBJ, size_t BLOCK_SIZE = 16>
+class EEPROM_SecureClass
+{
+public:
+	/** @brief Number of blocks occupied by the data object
+	 */
+	static const size_t BLOCK_COUNT = (sizeof(OBJ) + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+	/** @brief Size of the tag of each block (bytes)
+	 */
+	static const size_t TAG_SIZE = sizeof(uint64_t);
+
+	/** @brief Size of the EEPROM slot of each block (bytes)
+	 */
+	static const size_t SLOT_SIZE = EEPROM_Cipher::NONCE_SIZE + BLOCK_SIZE + TAG_SIZE;
+
+	/**
+	 * @brief Construct a new secure eeprom class object
+	 *
+	 */
+	EEPROM_SecureClass() : _blocksRead(0), _blocksWritten(0)
+	{
+		static_assert(BLOCK_SIZE <= 64, "BLOCK_SIZE must not exceed one ChaCha20 block");
+		Log.trace("in EEPROM_SecureClass Constructor.");
+		_invalidate();
+	}
+
+	/**
+	 * @brief Destroy the secure eeprom class object, clearing the keys and plaintext from RAM
+	 *
+	 */
+	~EEPROM_SecureClass()
+	{
+		Log.trace("in EEPROM_SecureClass Destructor.");
+		_wipe(_key, sizeof(_key));
+		_wipe(_macKey, sizeof(_macKey));
+		_wipe(_plain, sizeof(_plain));
+	}
+
+	/**
+	 * @brief Assign the EEPROM address and key of the object. No data is read until first access.
+	 *
+	 * @param address: EEPROM relative address for the saved object
+	 * @param key: EEPROM_Cipher::KEY_SIZE byte key
+	 * @return true: Object fits in EEPROM
+	 * @return false: Object exceeds EEPROM size
+	 */
+	bool begin(uint16_t address, const uint8_t *key)
+	{
+		uint8_t nonce[EEPROM_Cipher::NONCE_SIZE];
+
+		_adr_object = address;
+		_eepromSize = BLOCK_COUNT * SLOT_SIZE;
+		_invalidate();
+
+		// MAC key: keystream under a nonce no block uses
+		memcpy(_key, key, sizeof(_key));
+		memset(nonce, 0xFF, sizeof(nonce));
+		memset(_macKey, 0, sizeof(_macKey));
+		EEPROM_Cipher::chacha20(_key, nonce, 0, _macKey, sizeof(_macKey));
+		Log.trace("_adr_object: %d, _eepromSize: %d, blocks: %d", _adr_object, _eepromSize, BLOCK_COUNT);
+
+		if ((_adr_object + _eepromSize) > EEPROM.length())
+		{
+			Log.error("EEPROM secure object exceeds EEPROM size.");
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Encrypt and write a complete object
+	 *
+	 * Used to load defaults on first run or after an authentication error. Each block is written under a
+	 * fresh nonce.
+	 *
+	 * @param object
+	 */
+	void initialize(const OBJ &object)
+	{
+		memset(_plain, 0, sizeof(_plain));
+		memcpy(_plain, &object, sizeof(OBJ));
+		for (size_t block = 0; block < BLOCK_COUNT; block++)
+		{
+			_store(block);
+			_loaded[block] = true;
+		}
+		Log.trace("EEPROM secure object initialized.");
+	}
+
+	/**
+	 * @brief Decrypt the whole object
+	 *
+	 * @param object
+	 * @return true Object loaded
+	 * @return false A block failed authentication, object not loaded
+	 */
+	bool readObject(OBJ &object)
+	{
+		return read(0, &object, sizeof(OBJ));
+	}
+
+	/**
+	 * @brief Write the object, rewriting only the blocks that changed
+	 *
+	 * @param object
+	 * @return true Object written
+	 * @return false A block failed authentication
+	 */
+	bool writeObject(const OBJ &object)
+	{
+		return write(0, &object, sizeof(OBJ));
+	}
+
+	/**
+	 * @brief Read a data item from the object
+	 *
+	 * @param offset Offset of the item within the object (use offsetof())
+	 * @param value Item to receive the data
+	 * @return true Item loaded
+	 * @return false Offset out of range or block failed authentication
+	 */
+	template <class T>
+	bool get(size_t offset, T &value)
+	{
+		return read(offset, &value, sizeof(T));
+	}
+
+	/**
+	 * @brief Write a data item to the object
+	 *
+	 * @param offset Offset of the item within the object (use offsetof())
+	 * @param value New item value
+	 * @return true Item written
+	 * @return false Offset out of range or block failed authentication
+	 */
+	template <class T>
+	bool put(size_t offset, const T &value)
+	{
+		return write(offset, &value, sizeof(T));
+	}
+
+	/**
+	 * @brief Read a range of bytes from the object, decrypting the blocks on first access
+	 *
+	 * @param offset Offset within the object
+	 * @param dest Destination buffer
+	 * @param length Number of bytes
+	 * @return true Data loaded
+	 * @return false Range invalid or block failed authentication
+	 */
+	bool read(size_t offset, void *dest, size_t length)
+	{
+		if (!_loadRange(offset, length))
+		{
+			return false;
+		}
+		memcpy(dest, &_plain[offset], length);
+		return true;
+	}
+
+	/**
+	 * @brief Write a range of bytes to the object
+	 *
+	 * Only the blocks whose contents changed are re-encrypted and written to EEPROM.
+	 *
+	 * @param offset Offset within the object
+	 * @param src Source buffer
+	 * @param length Number of bytes
+	 * @return true Data written
+	 * @return false Range invalid or block failed authentication
+	 */
+	bool write(size_t offset, const void *src, size_t length)
+	{
+		const uint8_t *in = static_cast<const uint8_t *>(src);
+
+		if (!_loadRange(offset, length))
+		{
+			return false;
+		}
+
+		while (length > 0)
+		{
+			size_t block = offset / BLOCK_SIZE;
+			size_t start = offset % BLOCK_SIZE;
+			size_t count = min(length, BLOCK_SIZE - start);
+
+			if (memcmp(&_plain[offset], in, count) != 0)
+			{
+				memcpy(&_plain[offset], in, count);
+				_store(block);
+			}
+			in += count;
+			offset += count;
+			length -= count;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Authenticate all blocks directly from EEPROM. Does not decrypt or use the RAM copy.
+	 *
+	 * @return true All blocks valid
+	 * @return false One or more blocks invalid
+	 */
+	bool verify()
+	{
+		for (size_t block = 0; block < BLOCK_COUNT; block++)
+		{
+			uint8_t slot[SLOT_SIZE];
+
+			EEPROM.get(_slotAddress(block), slot);
+			if (!_authentic(block, slot))
+			{
+				Log.error("EEPROM secure object block %d invalid.", block);
+				return false;
+			}
+		}
+		Log.info("EEPROM secure object blocks valid.");
+		return true;
+	}
+
+	/**
+	 * @brief Get the Size of the object
+	 *
+	 * @return size_t object size in EEPROM, including nonces and tags
+	 */
+	size_t getSize() { return _eepromSize; }
+
+	/**
+	 * @brief Get the number of blocks read and authenticated since construction
+	 *
+	 * @return uint32_t block count
+	 */
+	uint32_t getBlocksRead() { return _blocksRead; }
+
+	/**
+	 * @brief Get the number of blocks written since construction
+	 *
+	 * @return uint32_t block count
+	 */
+	uint32_t getBlocksWritten() { return _blocksWritten; }
+
+protected:
+	/** @brief Address assigned to the data object in EEPROM.
+	 */
+	size_t _adr_object;
+
+	/** @brief Total memory size of the data object (bytes)
+	 */
+	size_t _eepromSize;
+
+private:
+	/** @brief Cipher key
+	 */
+	uint8_t _key[EEPROM_Cipher::KEY_SIZE];
+
+	/** @brief MAC key, derived from the cipher key
+	 */
+	uint8_t _macKey[EEPROM_Cipher::MAC_KEY_SIZE];
+
+	/** @brief Decrypted blocks
+	 */
+	uint8_t _plain[BLOCK_COUNT * BLOCK_SIZE];
+
+	/** @brief Block decrypted and verified
+	 */
+	bool _loaded[BLOCK_COUNT];
+
+	/** @brief Blocks read
+	 */
+	uint32_t _blocksRead;
+
+	/** @brief Blocks written
+	 */
+	uint32_t _blocksWritten;
+
+	/**
+	 * @brief Mark all blocks not loaded
+	 */
+	void _invalidate()
+	{
+		for (size_t block = 0; block < BLOCK_COUNT; block++)
+		{
+			_loaded[block] = false;
+		}
+	}
+
+	/**
+	 * @brief Check a range and load the blocks it covers
+	 *
+	 * @param offset Offset within the object
+	 * @param length Number of bytes
+	 * @return true Blocks loaded
+	 * @return false Range invalid or block failed authentication
+	 */
+	bool _loadRange(size_t offset, size_t length)
+	{
+		if ((offset + length) > sizeof(OBJ))
+		{
+			Log.error("EEPROM secure access out of range.");
+			return false;
+		}
+		if (length == 0)
+		{
+			return true;
+		}
+		for (size_t block = offset / BLOCK_SIZE; block <= (offset + length - 1) / BLOCK_SIZE; block++)
+		{
+			if (!_loaded[block] && !_load(block))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Read, authenticate and decrypt a block
+	 *
+	 * @param block Block number
+	 * @return true Block loaded
+	 * @return false Block failed authentication
+	 */
+	bool _load(size_t block)
+	{
+		uint8_t slot[SLOT_SIZE];
+
+		EEPROM.get(_slotAddress(block), slot);
+		_blocksRead++;
+		if (!_authentic(block, slot))
+		{
+			Log.error("EEPROM secure object block %d invalid.", block);
+			return false;
+		}
+
+		memcpy(&_plain[block * BLOCK_SIZE], &slot[EEPROM_Cipher::NONCE_SIZE], BLOCK_SIZE);
+		EEPROM_Cipher::chacha20(_key, slot, 0, &_plain[block * BLOCK_SIZE], BLOCK_SIZE);
+		_loaded[block] = true;
+		Log.trace("EEPROM secure object block %d loaded.", block);
+		return true;
+	}
+
+	/**
+	 * @brief Encrypt and write a block under a fresh nonce
+	 *
+	 * @param block Block number
+	 */
+	void _store(size_t block)
+	{
+		uint8_t slot[SLOT_SIZE];
+		uint64_t tag;
+
+		for (size_t i = 0; i < EEPROM_Cipher::NONCE_SIZE; i += sizeof(uint32_t))
+		{
+			uint32_t random = HAL_RNG_GetRandomNumber();
+
+			memcpy(&slot[i], &random, sizeof(random));
+		}
+		memcpy(&slot[EEPROM_Cipher::NONCE_SIZE], &_plain[block * BLOCK_SIZE], BLOCK_SIZE);
+		EEPROM_Cipher::chacha20(_key, slot, 0, &slot[EEPROM_Cipher::NONCE_SIZE], BLOCK_SIZE);
+		tag = _tag(block, slot);
+		memcpy(&slot[EEPROM_Cipher::NONCE_SIZE + BLOCK_SIZE], &tag, TAG_SIZE);
+
+		EEPROM_PUT_BLOCK(_slotAddress(block), slot, sizeof(slot));
+		_wipe(slot, sizeof(slot));
+		_blocksWritten++;
+	}
+
+	/**
+	 * @brief Check the tag of a block slot, in constant time
+	 *
+	 * @param block Block number
+	 * @param slot Slot as read from EEPROM
+	 * @return true Tag valid
+	 * @return false Tag invalid
+	 */
+	bool _authentic(size_t block, const uint8_t *slot)
+	{
+		uint64_t tag = _tag(block, slot);
+
+		return EEPROM_Cipher::equal(&tag, &slot[EEPROM_Cipher::NONCE_SIZE + BLOCK_SIZE], TAG_SIZE);
+	}
+
+	/**
+	 * @brief Calculate the tag of a block over its object address, block number, nonce and ciphertext
+	 *
+	 * @param block Block number
+	 * @param slot Slot holding the nonce and ciphertext
+	 */
+	uint64_t _tag(size_t block, const uint8_t *slot)
+	{
+		uint8_t message[2 * sizeof(uint32_t) + EEPROM_Cipher::NONCE_SIZE + BLOCK_SIZE];
+		uint32_t address = _adr_object;
+		uint32_t index = block;
+
+		memcpy(&message[0], &address, sizeof(address));
+		memcpy(&message[4], &index, sizeof(index));
+		memcpy(&message[8], slot, EEPROM_Cipher::NONCE_SIZE + BLOCK_SIZE);
+		return EEPROM_Cipher::siphash(_macKey, message, sizeof(message));
+	}
+
+	/**
+	 * @brief EEPROM address of a block slot
+	 */
+	size_t _slotAddress(size_t block) { return _adr_object + block * SLOT_SIZE; }
+
+	/**
+	 * @brief Clear sensitive data so that the compiler cannot drop the stores
+	 */
+	static void _wipe(void *data, size_t length)
+	{
+		volatile uint8_t *p = static_cast<volatile uint8_t *>(data);
+
+		while (length--)
+		{
+			*p++ = 0;
+		}
+	}
+};
@@ -0,0 +1,164 @@
+/**
+ * @file EEPROM_Snapshot.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief EEPROM Object Snapshot Format
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "EEPROM_Checksum.h"
+
+/**
+ * @brief Snapshot type tag of a data object type, declared with EEPROM_SNAPSHOT_TAG() (see EEPROM_Snapshot)
+ */
+template <class OBJ>
+struct EEPROM_SnapshotTag
+{
+	static_assert(sizeof(OBJ) == 0, "declare the snapshot type tag of the object with EEPROM_SNAPSHOT_TAG()");
+};
+
+//! @brief Declare the snapshot type tag of a data object type (at global scope)
+#define EEPROM_SNAPSHOT_TAG(type, tag)           \
+	template <>                                  \
+	struct EEPROM_SnapshotTag<type>              \
+	{                                            \
+		static const uint16_t TAG = (tag);       \
+	}
+
+/**
+ * @brief EEPROM Snapshot
+ * 
+ * Compact, versioned and checksummed binary image of a data object, used to provision a complete object in
+ * one transfer and one EEPROM write (see EEPROM_Class::exportSnapshot() and EEPROM_Class::importSnapshot()).
+ * 
+ * Format (all values little endian):
+ * | Offset | Size | Content |
+ * |--------|------|---------|
+ * | 0      | 2    | Magic "ES" |
+ * | 2      | 1    | Format version |
+ * | 3      | 1    | Reserved (0) |
+ * | 4      | 2    | Object size |
+ * | 6      | 2    | Object type tag (typeTag()) |
+ * | 8      | 2    | Checksum of the object bytes (EEPROM_Checksum) |
+ * | 10     | size | Object bytes |
+ * 
+ * The type tag identifies the object type, so that a snapshot of one type is not imported into another of
+ * the same size. Each type that is exported or imported declares its tag once, with EEPROM_SNAPSHOT_TAG(), at
+ * global scope. The tag is part of the stored format: it must not change when the type is renamed or the
+ * toolchain is upgraded, and should be changed only when the object's layout changes incompatibly.
+ * nameTag() gives a convenient value to start from.
+ * 
+ * @code
+ *     EEPROM_SNAPSHOT_TAG(CalibrationObject, 0x4341);
+ * @endcode
+ * 
+ * This header has no Particle dependencies, so host tools can generate snapshots for a whole fleet (see the
+ * snapshot_encode host tool).
+ */
+struct EEPROM_Snapshot
+{
+	//! @brief Size of the snapshot header (bytes)
+	static const size_t HEADER_SIZE = 10;
+
+	//! @brief Current format version
+	static const uint8_t VERSION = 2;
+
+	/**
+	 * @brief A tag value derived from a type name: 16-bit FNV-1a hash
+	 * 
+	 * Only a way to pick a tag; the value is then written into EEPROM_SNAPSHOT_TAG() as a constant.
+	 * 
+	 * @param name Type name as written in source, e.g. "SettingsObject"
+	 * @param length Length of the name
+	 * @return uint16_t type tag
+	 */
+	static uint16_t nameTag(const char *name, size_t length)
+	{
+		uint32_t hash = 2166136261UL;
+
+		for (size_t i = 0; i < length; i++)
+		{
+			hash = (hash ^ (uint8_t)name[i]) * 16777619UL;
+		}
+		return (uint16_t)(hash ^ (hash >> 16));
+	}
+
+	/**
+	 * @brief Type tag of a data object type, as declared with EEPROM_SNAPSHOT_TAG()
+	 * 
+	 * @tparam OBJ Data object type
+	 * @return uint16_t type tag
+	 */
+	template <class OBJ>
+	static uint16_t typeTag()
+	{
+		return EEPROM_SnapshotTag<OBJ>::TAG;
+	}
+
+	/**
+	 * @brief Encode an object into a snapshot
+	 * 
+	 * @param object Object bytes
+	 * @param size Object size
+	 * @param tag Object type tag
+	 * @param buffer Destination buffer
+	 * @param length Size of the destination buffer
+	 * @return size_t Snapshot length, 0 if the buffer is too small
+	 */
+	static size_t encode(const void *object, size_t size, uint16_t tag, uint8_t *buffer, size_t length)
+	{
+		if ((length < HEADER_SIZE + size) || (size > 0xFFFF))
+		{
+			return 0;
+		}
+
+		uint16_t checkSum = EEPROM_Checksum::calculate(object, size);
+
+		buffer[0] = 'E';
+		buffer[1] = 'S';
+		buffer[2] = VERSION;
+		buffer[3] = 0;
+		buffer[4] = size & 0xFF;
+		buffer[5] = size >> 8;
+		buffer[6] = tag & 0xFF;
+		buffer[7] = tag >> 8;
+		buffer[8] = checkSum & 0xFF;
+		buffer[9] = checkSum >> 8;
+		memcpy(&buffer[HEADER_SIZE], object, size);
+		return HEADER_SIZE + size;
+	}
+
+	/**
+	 * @brief Validate a snapshot and locate the object bytes
+	 * 
+	 * @param buffer Snapshot
+	 * @param length Snapshot length
+	 * @param size Expected object size
+	 * @param tag Expected object type tag
+	 * @return const uint8_t* Object bytes within the snapshot, NULL if invalid
+	 */
+	static const uint8_t *decode(const uint8_t *buffer, size_t length, size_t size, uint16_t tag)
+	{
+		if ((length != HEADER_SIZE + size) || (buffer[0] != 'E') || (buffer[1] != 'S') || (buffer[2] != VERSION))
+		{
+			return NULL;
+		}
+
+		if (((size_t)(buffer[4] | (buffer[5] << 8)) != size) || ((uint16_t)(buffer[6] | (buffer[7] << 8)) != tag))
+		{
+			return NULL;
+		}
+
+		if ((uint16_t)(buffer[8] | (buffer[9] << 8)) != EEPROM_Checksum::calculate(&buffer[HEADER_SIZE], size))
+		{
+			return NULL;
+		}
+		return &buffer[HEADER_SIZE];
+	}
+};
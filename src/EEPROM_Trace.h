@@ -0,0 +1,249 @@
+/**
+ * @file EEPROM_Trace.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief EEPROM Operation Tracing
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#pragma once
+#include <Particle.h>
+
+/**
+ * @brief Trace hooks for EEPROM_Class operations
+ * 
+ * When EEPROM_TRACE is defined for the whole build (e.g. EXTRA_CFLAGS=-DEEPROM_TRACE in a local build, so that
+ * the library sources see it too), EEPROM_Class records a timestamped span for each begin, read, verify, write, EEPROM.put and
+ * checksum update into a RAM ring buffer. EEPROM_Trace::dump() prints the buffer as Chrome trace_event
+ * JSON, which can be saved from the serial terminal and opened in chrome://tracing or Perfetto. EEPROM_Trace::exportBinary()
+ * exports the same spans in the compact EEPROM_TraceFormat, e.g. for upload from devices in the field and replay
+ * with EEPROM_Replay.
+ * 
+ * When EEPROM_TRACE is not defined the hooks compile to nothing, and EEPROM_Trace and EEPROM_TraceSpan are not
+ * declared, so untraced builds carry none of the trace machinery.
+ * 
+ * @code
+ *     #define EEPROM_TRACE
+ *     #include "UserSettingsClass.h"
+ *     ...
+ *     mySettings.setHostName("NewHostName");
+ *     EEPROM_Trace::dump(Serial);
+ * @endcode
+ */
+
+#ifdef EEPROM_TRACE
+#include <atomic>
+#include "EEPROM_TraceFormat.h"
+
+#ifndef EEPROM_TRACE_SIZE
+//! @brief Number of spans held in the trace buffer
+#define EEPROM_TRACE_SIZE 64
+#endif
+
+/**
+ * @brief Trace buffer
+ * 
+ * Writers claim a slot with a single atomic increment, then publish the span with a stamp in the slot, so spans
+ * may be recorded from any thread without locking. dump() and exportBinary() skip a span that is still being
+ * written, or that is overwritten while they read it, rather than report it half written. The oldest spans are
+ * overwritten when the buffer is full.
+ */
+class EEPROM_Trace
+{
+public:
+	/**
+	 * @brief Record a span
+	 * 
+	 * @param op Operation
+	 * @param address EEPROM address
+	 * @param length Number of bytes
+	 * @param start Start time (microseconds)
+	 * @param duration Duration (microseconds)
+	 */
+	static void record(uint8_t op, uint16_t address, uint32_t length, uint32_t start, uint32_t duration)
+	{
+		uint32_t index = _next().fetch_add(1, std::memory_order_relaxed);
+		Slot &slot = _slots()[index % EEPROM_TRACE_SIZE];
+
+		// Unpublish the slot before its fields change, then publish it with its index
+		slot.stamp.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		slot.event.start = start;
+		slot.event.duration = duration;
+		slot.event.address = address;
+		slot.event.length = length;
+		slot.event.op = op;
+		slot.stamp.store(index + 1, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Print the recorded spans as Chrome trace_event JSON, oldest first
+	 * 
+	 * @param out Output stream, e.g. Serial
+	 */
+	static void dump(Print &out)
+	{
+		uint32_t next = _next().load(std::memory_order_acquire);
+		uint32_t first = (next > EEPROM_TRACE_SIZE) ? next - EEPROM_TRACE_SIZE : 0;
+		bool separator = false;
+
+		out.print("{\"traceEvents\":[");
+		for (uint32_t i = first; i < next; i++)
+		{
+			EEPROM_TraceEvent event;
+			char text[EEPROM_TraceFormat::JSON_SIZE];
+
+			if (!_read(i, event))
+			{
+				continue;
+			}
+			EEPROM_TraceFormat::formatJson(event, text, sizeof(text));
+			out.print(separator ? ",\n" : "");
+			out.print(text);
+			separator = true;
+		}
+		out.println("]}");
+	}
+
+	/**
+	 * @brief Export the recorded spans in the binary trace format (EEPROM_TraceFormat), oldest first
+	 * 
+	 * If the buffer cannot hold every span, the newest spans that fit are exported.
+	 * 
+	 * @param buffer Destination buffer
+	 * @param length Size of the destination buffer
+	 * @return size_t Trace length, 0 if the buffer cannot hold the header
+	 */
+	static size_t exportBinary(uint8_t *buffer, size_t length)
+	{
+		if (length < EEPROM_TraceFormat::HEADER_SIZE)
+		{
+			return 0;
+		}
+
+		uint32_t next = _next().load(std::memory_order_acquire);
+		uint32_t count = (next > EEPROM_TRACE_SIZE) ? EEPROM_TRACE_SIZE : next;
+		uint32_t room = (length - EEPROM_TraceFormat::HEADER_SIZE) / EEPROM_TraceFormat::RECORD_SIZE;
+
+		if (count > room)
+		{
+			count = room;
+		}
+		uint16_t written = 0;
+		for (uint32_t i = next - count; i < next; i++)
+		{
+			EEPROM_TraceEvent event;
+
+			if (_read(i, event))
+			{
+				EEPROM_TraceFormat::encodeRecord(event, &buffer[EEPROM_TraceFormat::HEADER_SIZE + written * EEPROM_TraceFormat::RECORD_SIZE]);
+				written++;
+			}
+		}
+		EEPROM_TraceFormat::encodeHeader(buffer, written);
+		return EEPROM_TraceFormat::HEADER_SIZE + written * EEPROM_TraceFormat::RECORD_SIZE;
+	}
+
+	/**
+	 * @brief Discard all recorded spans
+	 * 
+	 */
+	static void clear()
+	{
+		_next().store(0, std::memory_order_relaxed);
+		for (size_t i = 0; i < EEPROM_TRACE_SIZE; i++)
+		{
+			_slots()[i].stamp.store(0, std::memory_order_release);
+		}
+	}
+
+private:
+	/**
+	 * @brief Span storage, with its publication stamp
+	 */
+	struct Slot
+	{
+		/** Index of the span + 1 once published, 0 while empty or being written */
+		std::atomic<uint32_t> stamp;
+		/** Span */
+		EEPROM_TraceEvent event;
+	};
+
+	/**
+	 * @brief Index of the next slot to be written
+	 */
+	static std::atomic<uint32_t> &_next()
+	{
+		static std::atomic<uint32_t> next(0);
+		return next;
+	}
+
+	/**
+	 * @brief Span storage
+	 */
+	static Slot *_slots()
+	{
+		static Slot slots[EEPROM_TRACE_SIZE];
+		return slots;
+	}
+
+	/**
+	 * @brief Read a published span
+	 * 
+	 * @param index Span index
+	 * @param event Receives the span
+	 * @return true Span read
+	 * @return false Span not yet published, being written or overwritten
+	 */
+	static bool _read(uint32_t index, EEPROM_TraceEvent &event)
+	{
+		Slot &slot = _slots()[index % EEPROM_TRACE_SIZE];
+
+		if (slot.stamp.load(std::memory_order_acquire) != index + 1)
+		{
+			return false;
+		}
+		event = slot.event;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return slot.stamp.load(std::memory_order_relaxed) == index + 1;
+	}
+};
+
+/**
+ * @brief Scoped span: records the time from construction to destruction
+ */
+class EEPROM_TraceSpan
+{
+public:
+	/**
+	 * @brief Start a span
+	 * 
+	 * @param op Operation
+	 * @param address EEPROM address
+	 * @param length Number of bytes
+	 */
+	EEPROM_TraceSpan(uint8_t op, uint16_t address, uint32_t length) : _start(micros()), _address(address), _length(length), _op(op) {}
+
+	/**
+	 * @brief End the span and record it
+	 * 
+	 */
+	~EEPROM_TraceSpan()
+	{
+		EEPROM_Trace::record(_op, _address, _length, _start, micros() - _start);
+	}
+
+private:
+	uint32_t _start;
+	uint16_t _address;
+	uint32_t _length;
+	uint8_t _op;
+};
+
+//! @brief Record a span covering the rest of the enclosing scope
+#define EEPROM_TRACE_SPAN(op, address, length) EEPROM_TraceSpan _traceSpan(op, address, length)
+#else
+#define EEPROM_TRACE_SPAN(op, address, length)
+#endif
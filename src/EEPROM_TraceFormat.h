@@ -0,0 +1,215 @@
+/**
+ * @file EEPROM_TraceFormat.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief EEPROM Operation Trace Records and Binary Format
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "EEPROM_Checksum.h"
+
+/**
+ * @brief Traced operation types
+ */
+enum EEPROM_TraceOp
+{
+	TRACE_BEGIN,	//!< begin()
+	TRACE_READ,		//!< readObject()
+	TRACE_VERIFY,	//!< checksum verification
+	TRACE_WRITE,	//!< object write, including checksum update
+	TRACE_PUT,		//!< EEPROM.put() of the object
+	TRACE_CHECKSUM,	//!< checksum calculation and store
+	TRACE_VERIFY_CACHED	//!< verifyChecksum() answered from its cache, without reading EEPROM
+};
+
+/**
+ * @brief Trace span recorded in the buffer
+ */
+struct EEPROM_TraceEvent
+{
+	/** Start time (microseconds) */
+	uint32_t start;
+	/** Duration (microseconds) */
+	uint32_t duration;
+	/** EEPROM address */
+	uint16_t address;
+	/** Number of bytes */
+	uint32_t length;
+	/** Operation (EEPROM_TraceOp) */
+	uint8_t op;
+};
+
+/**
+ * @brief Binary trace format
+ * 
+ * Compact export of a recorded trace (see EEPROM_Trace::exportBinary()), for capture from devices in the field and
+ * replay with EEPROM_Replay.
+ * 
+ * Format (all values little endian):
+ * | Offset | Size | Content |
+ * |--------|------|---------|
+ * | 0      | 2    | Magic "ET" |
+ * | 2      | 1    | Format version |
+ * | 3      | 1    | Reserved (0) |
+ * | 4      | 2    | Number of records |
+ * | 6      | 2    | Checksum of the record bytes (EEPROM_Checksum) |
+ * | 8      | 16 each | Records, oldest first |
+ * 
+ * Record:
+ * | Offset | Size | Content |
+ * |--------|------|---------|
+ * | 0      | 4    | Start time (microseconds) |
+ * | 4      | 4    | Duration (microseconds) |
+ * | 8      | 2    | EEPROM address |
+ * | 10     | 1    | Operation (EEPROM_TraceOp) |
+ * | 11     | 1    | Reserved (0) |
+ * | 12     | 4    | Number of bytes |
+ * 
+ * Version 1 traces (12-byte records, with the operation and number of bytes packed into 3 and 13 bits) are not
+ * accepted.
+ * 
+ * This header has no Particle dependencies, so host tools can decode traces and print them in the same
+ * Chrome trace_event JSON as EEPROM_Trace::dump().
+ */
+struct EEPROM_TraceFormat
+{
+	//! @brief Size of the trace header (bytes)
+	static const size_t HEADER_SIZE = 8;
+
+	//! @brief Size of one record (bytes)
+	static const size_t RECORD_SIZE = 16;
+
+	//! @brief Current format version
+	static const uint8_t VERSION = 2;
+
+	//! @brief Buffer size for one event in JSON (formatJson())
+	static const size_t JSON_SIZE = 160;
+
+	/**
+	 * @brief Get the name of an operation, as used in JSON output
+	 * 
+	 * @param op Operation (EEPROM_TraceOp)
+	 * @return const char* name, "unknown" if not an operation
+	 */
+	static const char *opName(uint8_t op)
+	{
+		static const char *const names[] = {"begin", "read", "verify", "write", "put", "checksum", "verify_cached"};
+
+		return (op < sizeof(names) / sizeof(names[0])) ? names[op] : "unknown";
+	}
+
+	/**
+	 * @brief Format one span as a Chrome trace_event JSON object ("complete" event, times in microseconds)
+	 * 
+	 * @param event Span
+	 * @param buffer Destination, JSON_SIZE bytes
+	 * @param size Size of the destination
+	 * @return int Length of the text (as snprintf())
+	 */
+	static int formatJson(const EEPROM_TraceEvent &event, char *buffer, size_t size)
+	{
+		return snprintf(buffer, size, "{\"name\":\"%s\",\"cat\":\"eeprom\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%lu,\"pid\":1,\"tid\":1,\"args\":{\"address\":%u,\"length\":%lu}}",
+						opName(event.op), (unsigned long)event.start, (unsigned long)event.duration, event.address, (unsigned long)event.length);
+	}
+
+	/**
+	 * @brief Encode one record
+	 * 
+	 * @param event Span
+	 * @param record Destination, RECORD_SIZE bytes
+	 */
+	static void encodeRecord(const EEPROM_TraceEvent &event, uint8_t *record)
+	{
+		static_assert(TRACE_VERIFY_CACHED <= 0xFF, "EEPROM_TraceOp must fit the operation byte of a record");
+
+		_put32(&record[0], event.start);
+		_put32(&record[4], event.duration);
+		_put16(&record[8], event.address);
+		record[10] = event.op;
+		record[11] = 0;
+		_put32(&record[12], event.length);
+	}
+
+	/**
+	 * @brief Decode one record
+	 * 
+	 * @param record Source, RECORD_SIZE bytes
+	 * @param event Span
+	 */
+	static void decodeRecord(const uint8_t *record, EEPROM_TraceEvent &event)
+	{
+		event.start = _get32(&record[0]);
+		event.duration = _get32(&record[4]);
+		event.address = _get16(&record[8]);
+		event.op = record[10];
+		event.length = _get32(&record[12]);
+	}
+
+	/**
+	 * @brief Encode the header, once the records are in place
+	 * 
+	 * @param buffer Trace, with count records following the header
+	 * @param count Number of records
+	 */
+	static void encodeHeader(uint8_t *buffer, uint16_t count)
+	{
+		buffer[0] = 'E';
+		buffer[1] = 'T';
+		buffer[2] = VERSION;
+		buffer[3] = 0;
+		_put16(&buffer[4], count);
+		_put16(&buffer[6], EEPROM_Checksum::calculate(&buffer[HEADER_SIZE], count * RECORD_SIZE));
+	}
+
+	/**
+	 * @brief Validate a trace
+	 * 
+	 * @param buffer Trace
+	 * @param length Trace length
+	 * @return int Number of records, -1 if invalid
+	 */
+	static int decodeHeader(const uint8_t *buffer, size_t length)
+	{
+		if ((length < HEADER_SIZE) || (buffer[0] != 'E') || (buffer[1] != 'T') || (buffer[2] != VERSION))
+		{
+			return -1;
+		}
+
+		size_t count = _get16(&buffer[4]);
+
+		if ((length != HEADER_SIZE + count * RECORD_SIZE) || (_get16(&buffer[6]) != EEPROM_Checksum::calculate(&buffer[HEADER_SIZE], count * RECORD_SIZE)))
+		{
+			return -1;
+		}
+		return count;
+	}
+
+private:
+	static void _put16(uint8_t *p, uint16_t value)
+	{
+		p[0] = value & 0xFF;
+		p[1] = value >> 8;
+	}
+
+	static void _put32(uint8_t *p, uint32_t value)
+	{
+		_put16(p, value & 0xFFFF);
+		_put16(p + 2, value >> 16);
+	}
+
+	static uint16_t _get16(const uint8_t *p)
+	{
+		return p[0] | (p[1] << 8);
+	}
+
+	static uint32_t _get32(const uint8_t *p)
+	{
+		return _get16(p) | ((uint32_t)_get16(p + 2) << 16);
+	}
+};
@@ -0,0 +1,90 @@
+/**
+ * @file EEPROM_WearBudget.cpp
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief EEPROM Wear Budget Class Member Functions
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+
+#include <Particle.h>
+#include "EEPROM_WearBudget.h"
+
+void EEPROM_WearBudget::configure(uint32_t writesPerHour, uint32_t lifetimeWrites)
+{
+	_writesPerHour = writesPerHour;
+	// Rates above one write per millisecond refill at one write per millisecond
+	_refillInterval = (writesPerHour > 0) ? max(3600000UL / writesPerHour, 1UL) : 0;
+	_tokens = writesPerHour;
+	_lastRefill = _clock();
+	_lifetimeLimit = lifetimeWrites;
+	Log.trace("Wear budget: %lu writes/hour, lifetime limit: %lu", (unsigned long)writesPerHour, (unsigned long)lifetimeWrites);
+}
+
+bool EEPROM_WearBudget::consume(bool ignoreRate)
+{
+	if ((_lifetimeLimit > 0) && (_lifetimeWrites >= _lifetimeLimit))
+	{
+		return false;
+	}
+
+	if (_writesPerHour > 0)
+	{
+		_refill();
+		if (_tokens > 0)
+		{
+			_tokens--;
+		}
+		else if (!ignoreRate)
+		{
+			return false;
+		}
+	}
+
+	_lifetimeWrites++;
+	return true;
+}
+
+uint32_t EEPROM_WearBudget::getRemaining()
+{
+	if (_writesPerHour == 0)
+	{
+		return UNLIMITED;
+	}
+	_refill();
+	return _tokens;
+}
+
+uint32_t EEPROM_WearBudget::getRemainingLifetime()
+{
+	if (_lifetimeLimit == 0)
+	{
+		return UNLIMITED;
+	}
+	return (_lifetimeWrites < _lifetimeLimit) ? (_lifetimeLimit - _lifetimeWrites) : 0;
+}
+
+void EEPROM_WearBudget::_refill()
+{
+	uint32_t now = _clock();
+	uint32_t earned = (now - _lastRefill) / _refillInterval;
+
+	if (earned == 0)
+	{
+		return;
+	}
+
+	if (earned >= (_writesPerHour - _tokens))
+	{
+		// Bucket full, restart the refill interval from now
+		_tokens = _writesPerHour;
+		_lastRefill = now;
+	}
+	else
+	{
+		_tokens += earned;
+		_lastRefill += earned * _refillInterval;
+	}
+}
@@ -0,0 +1,128 @@
+/**
+ * @file EEPROM_WearBudget.h
+ * @author Randy E. Rainwater (randyrtx@outlook.com)
+ * @brief EEPROM Wear Budget Class Header
+ * @version 1.2.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2019
+ * 
+ */
+#pragma once
+#include <Particle.h>
+
+/**
+ * @brief EEPROM Wear Budget
+ * 
+ * Token bucket limiting the rate (writes per hour) and total number of writes made by an EEPROM_Class
+ * instance. Tokens refill continuously at the hourly rate, up to one hour's worth of writes.
+ * 
+ * The time source defaults to millis() and may be replaced (e.g. with a simulated clock for testing).
+ * 
+ * The lifetime count is held in RAM only. To enforce the lifetime limit across resets, persist
+ * getLifetimeWrites() (e.g. with the other settings, or on shutdown) and restore it with setLifetimeWrites().
+ */
+class EEPROM_WearBudget
+{
+public:
+	/** @brief Time source returning milliseconds
+	 */
+	typedef uint32_t (*Clock)();
+
+	//! @brief Value used for "no limit"
+	static const uint32_t UNLIMITED = 0xFFFFFFFF;
+
+	/**
+	 * @brief Construct a new wear budget object (unlimited)
+	 * 
+	 */
+	EEPROM_WearBudget() {}
+
+	/**
+	 * @brief Set the budget limits. Starts with a full hour's worth of writes.
+	 * 
+	 * The refill rate is at most one write per millisecond; a higher writesPerHour only raises the burst size.
+	 * 
+	 * @param writesPerHour Maximum sustained writes per hour, 0 for no rate limit
+	 * @param lifetimeWrites Maximum total writes, 0 for no limit
+	 */
+	void configure(uint32_t writesPerHour, uint32_t lifetimeWrites = 0);
+
+	/**
+	 * @brief Set the time source
+	 * 
+	 * @param clock function returning milliseconds
+	 */
+	void setClock(Clock clock) { _clock = clock; }
+
+	/**
+	 * @brief Set the total writes made so far, e.g. restored from a persisted count
+	 * 
+	 * @param count writes already made
+	 */
+	void setLifetimeWrites(uint32_t count) { _lifetimeWrites = count; }
+
+	/**
+	 * @brief Get the total writes made so far, including any count restored with setLifetimeWrites()
+	 * 
+	 * @return uint32_t writes made
+	 */
+	uint32_t getLifetimeWrites() { return _lifetimeWrites; }
+
+	/**
+	 * @brief Take one write from the budget if available
+	 * 
+	 * @param ignoreRate take the write even if the rate limit is exhausted (the lifetime limit still applies)
+	 * @return true Write allowed
+	 * @return false Budget exhausted, write must be held
+	 */
+	bool consume(bool ignoreRate = false);
+
+	/**
+	 * @brief Get the number of writes currently available under the rate limit
+	 * 
+	 * @return uint32_t available writes, UNLIMITED if no rate limit
+	 */
+	uint32_t getRemaining();
+
+	/**
+	 * @brief Get the number of writes left under the lifetime limit
+	 * 
+	 * @return uint32_t remaining writes, UNLIMITED if no lifetime limit
+	 */
+	uint32_t getRemainingLifetime();
+
+private:
+	/** @brief Time source
+	 */
+	Clock _clock = millis;
+
+	/** @brief Maximum writes per hour (bucket capacity), 0 = no rate limit
+	 */
+	uint32_t _writesPerHour = 0;
+
+	/** @brief Milliseconds to earn one write, at least 1
+	 */
+	uint32_t _refillInterval = 0;
+
+	/** @brief Writes currently available
+	 */
+	uint32_t _tokens = 0;
+
+	/** @brief Time of the last token refill
+	 */
+	uint32_t _lastRefill = 0;
+
+	/** @brief Maximum total writes, 0 = no limit
+	 */
+	uint32_t _lifetimeLimit = 0;
+
+	/** @brief Total writes made
+	 */
+	uint32_t _lifetimeWrites = 0;
+
+	/**
+	 * @brief Add tokens earned since the last refill
+	 */
+	void _refill();
+};
@@ -12,14 +12,40 @@
 #include <Particle.h>
 #include "UserSettingsClass.h"
 
+//! @brief Antenna type names
+static const EEPROM_EnumName antennaNames[] = {
+    {ANT_INTERNAL, "Internal"},
+    {ANT_EXTERNAL, "External"},
+    {ANT_AUTO, "Auto"},
+};
+
+//! @cond
+#define USER_SETTING_FLOAT_DEFAULT(member, getter, setter, defaultValue, label, format, minValue, maxValue) defaultValue,
+#define USER_SETTING_BOOL_DEFAULT(member, getter, setter, defaultValue, label) defaultValue,
+#define USER_SETTING_STRING_DEFAULT(member, size, getter, setter, defaultValue, label) defaultValue,
+#define USER_SETTING_ENUM_DEFAULT(type, member, getter, setter, defaultValue, label, names) defaultValue,
+
+#define USER_SETTING_FLOAT_FIELD(member, getter, setter, defaultValue, label, format, minValue, maxValue) EEPROM_FIELD_FLOAT_FORMAT(SettingsObject, member, label, format, minValue, maxValue),
+#define USER_SETTING_BOOL_FIELD(member, getter, setter, defaultValue, label) EEPROM_FIELD_BOOL(SettingsObject, member, label),
+#define USER_SETTING_STRING_FIELD(member, size, getter, setter, defaultValue, label) EEPROM_FIELD_STRING(SettingsObject, member, label),
+#define USER_SETTING_ENUM_FIELD(type, member, getter, setter, defaultValue, label, names) EEPROM_FIELD_ENUM(SettingsObject, member, label, names),
+//! @endcond
+
+const SettingsObject UserSettingsClass::defaultSettings = {
+    USER_SETTINGS(USER_SETTING_FLOAT_DEFAULT, USER_SETTING_BOOL_DEFAULT, USER_SETTING_STRING_DEFAULT, USER_SETTING_ENUM_DEFAULT)
+};
+
+const EEPROM_Field UserSettingsClass::fields[] = {
+    USER_SETTINGS(USER_SETTING_FLOAT_FIELD, USER_SETTING_BOOL_FIELD, USER_SETTING_STRING_FIELD, USER_SETTING_ENUM_FIELD)
+};
+
+const size_t UserSettingsClass::fieldCount = sizeof(fields) / sizeof(fields[0]);
+
 bool UserSettingsClass::begin(uint16_t address)
 {
+    EEPROM_TRACE_SPAN(TRACE_BEGIN, address, sizeof(_mySettings));
     bool flag;
-    _adr_checksum = address;
-    _adr_object = _adr_checksum + sizeof(_checksum);
-    _eepromSize = sizeof(_mySettings) + sizeof(_checksum);
-    EEPROM.get(_adr_checksum, _checksum);
-    Log.trace("_adr_checksum: %d, _adr_object: %d, _eepromSize: %d, checksum: 0x%04X", _adr_checksum, _adr_object, _eepromSize, _checksum);
+    _setAddress(address);
 
     flag = readObject(_mySettings);
     if (!flag)
@@ -42,35 +68,13 @@ void UserSettingsClass::reinitialize()
 
     // Set local data to defaults
 
-    _mySettings.timeZone = DEFAULT_USER_TZ;
-    _mySettings.dstOffset = DEFAULT_USER_DSTOFFSET;
-    _mySettings.dstEnabled = DEFAULT_USER_DSTENABLE;
-    strcpy(_mySettings.hostName, DEFAULT_USER_HOSTNAME);
-    _mySettings.antennaType = DEFAULT_USER_ANTENNA;
+    _mySettings = defaultSettings;
 
     // Reload EEPROM
 
     writeObject(_mySettings);
 
-    Log.trace("Time Settings -- Timezone: %0.2f, DST Offset: %f, DST Enabled: %s", _mySettings.timeZone, _mySettings.dstOffset, (_mySettings.dstEnabled) ? "Yes" : "No");
-    Log.trace("Hostname: %s", _mySettings.hostName);
-    switch (_mySettings.antennaType)
-    {
-    case ANT_INTERNAL:
-        Log.trace("Antenna Type: Internal");
-        break;
-
-    case ANT_EXTERNAL:
-        Log.trace("Antenna Type: External");
-        break;
-
-    case ANT_AUTO:
-        Log.trace("Antenna Type: Auto");
-        break;
-
-    default:
-        break;
-    }
+    EEPROM_Fields::log(LOG_LEVEL_TRACE, fields, fieldCount, &_mySettings);
 }
 
 /**
@@ -80,47 +84,76 @@ void UserSettingsClass::reinitialize()
 void UserSettingsClass::logUserData()
 {
     Log.info("Stored User Data from EEPROM:");
-    Log.info("Timezone: %0.2f", _mySettings.timeZone);
-    Log.info("DST Offset: %4.1f", _mySettings.dstOffset);
-    Log.info("DST Enabled: %s", (_mySettings.dstEnabled) ? "Yes" : "No");
-    Log.info("Hostname: %s", _mySettings.hostName);
+    EEPROM_Fields::log(LOG_LEVEL_INFO, fields, fieldCount, &_mySettings);
+    Log.info("Checksum: 0x%04X\n", _checksum);
+}
 
-    switch (_mySettings.antennaType)
+bool UserSettingsClass::_setString(char *item, size_t size, const char *value, size_t length)
+{
+    bool flag = true;
+    bool changed;
+
+    // Range check:
+    if (length > (size - 1))
     {
-    case ANT_INTERNAL:
-        Log.info("Antenna Type: Internal");
-        break;
+        length = size - 1;
+        flag = false;
+    }
 
-    case ANT_EXTERNAL:
-        Log.info("Antenna Type: External");
-        break;
+    // The unused tail is kept clear so that equal strings give equal images: write only if the string changed
+    changed = (memcmp(item, value, length) != 0);
+    for (size_t i = length; !changed && (i < size); i++)
+    {
+        changed = (item[i] != 0);
+    }
+    if (changed)
+    {
+        memcpy(item, value, length);
+        memset(&item[length], 0, size - length);
+        writeObject(_mySettings);
+    }
 
-    case ANT_AUTO:
-        Log.info("Antenna Type: Auto");
-        break;
+    if (!flag)
+    {
+        const EEPROM_Field *field = EEPROM_Fields::find(fields, fieldCount, reinterpret_cast<uint8_t *>(item) - reinterpret_cast<uint8_t *>(&_mySettings));
 
-    default:
-        break;
+        Log.warn("%s too long, truncated.", (field != NULL) ? field->label : "Setting");
     }
+    return flag;
+}
 
-    Log.info("Checksum: 0x%04X\n", _checksum);
+bool UserSettingsClass::_validateImage(const uint8_t *data)
+{
+    SettingsObject candidate;
+
+    // Validate a copy, so that the working settings are untouched if any field is rejected
+    memcpy(&candidate, data, sizeof(candidate));
+    for (size_t i = 0; i < fieldCount; i++)
+    {
+        if (!EEPROM_Fields::validate(fields[i], reinterpret_cast<const uint8_t *>(&candidate) + fields[i].offset))
+        {
+            Log.warn("Invalid %s in snapshot.", fields[i].name);
+            return false;
+        }
+    }
+    return true;
 }
 
-bool UserSettingsClass::setHostName(String hostName)
+bool UserSettingsClass::_setItem(void *item, const void *value, size_t size)
 {
-    // Range check:
-    if (hostName.length() > (sizeof(_mySettings.hostName) - 1))
+    const EEPROM_Field *field = EEPROM_Fields::find(fields, fieldCount, static_cast<uint8_t *>(item) - reinterpret_cast<uint8_t *>(&_mySettings));
+
+    if ((field != NULL) && !EEPROM_Fields::validate(*field, value))
     {
-        strncpy(_mySettings.hostName, hostName, sizeof(_mySettings.hostName) - 1);
-        _mySettings.hostName[sizeof(_mySettings.hostName) - 1] = '\0';
-        writeObject(_mySettings);
-        Log.warn("Hostname too long, truncated.");
+        Log.warn("Invalid %s, setting not changed.", field->name);
         return false;
     }
-    else
+
+    // Unchanged values cost no EEPROM write
+    if (memcmp(item, value, size) != 0)
     {
-        strcpy(_mySettings.hostName, hostName);
+        memcpy(item, value, size);
         writeObject(_mySettings);
-        return true;
     }
+    return true;
 }
@@ -17,11 +17,32 @@
  * | 1.1.0   | 2019-09-21 | Changed timeZone to use float for    |
  * |         |            | consistency with system.             |
  * ---------------------------------------------------------------
+ * | 1.2.0   | 2026-10-18 | Heap-free hostname API: const char*  |
+ * |         |            | setters, read-only getHostName().    |
+ * |         | 2026-10-18 | Defaults held in flash, optional     |
+ * |         |            | sparse (overlay) storage.            |
+ * |         | 2026-10-18 | Field table drives validation and    |
+ * |         |            | logging; setters return bool.        |
+ * |         | 2026-10-18 | attach() for EEPROM_BootLoader.      |
+ * |         | 2026-10-18 | Explicit constructor; setHostName()  |
+ * |         |            | skips the write if unchanged.        |
+ * |         | 2026-10-18 | Snapshot imports validated against   |
+ * |         |            | the field table.                     |
+ * |         | 2026-10-18 | USER_SETTINGS() table generates the  |
+ * |         |            | members, defaults, fields[] and      |
+ * |         |            | accessors.                           |
+ * |         | 2026-10-18 | Defaults batched by EEPROM_Boot-     |
+ * |         |            | Loader, in either mode.              |
+ * |         | 2026-10-18 | Explicit snapshot type tag.          |
+ * |         | 2026-10-18 | Log format per float setting: DST    |
+ * |         |            | Offset logged as %4.1f again.        |
+ * ---------------------------------------------------------------
  * 
  */
 #pragma once
 #include <Particle.h>
 #include "EEPROM_Class.h"
+#include "EEPROM_Fields.h"
 
 //! @brief Default Timezone
 #define DEFAULT_USER_TZ -6
@@ -34,6 +55,35 @@
 //! @brief Default Antenna Type
 #define DEFAULT_USER_ANTENNA ANT_INTERNAL
 
+/**************************************************
+ * @brief Settings Table
+ * 
+ * Every setting is one entry, which generates its SettingsObject member, its default, its fields[] entry
+ * (validation and logging) and its getter and setter. Each kind of setting is expanded by the macro of that
+ * name passed to USER_SETTINGS():
+ * 	- FLOAT(member, getter, setter, default, label, format, minValue, maxValue): format is the printf format
+ * 	  of the logged value
+ * 	- BOOL(member, getter, setter, default, label)
+ * 	- STRING(member, size, getter, setter, default, label): size includes the terminating null
+ * 	- ENUM(type, member, getter, setter, default, label, names): names is an EEPROM_EnumName table of the
+ * 	  valid values, defined in UserSettingsClass.cpp
+ * 
+ * Entries are in SettingsObject member order; append new settings at the end so that stored images keep
+ * their layout (a changed layout fails the checksum and reinitializes to defaults).
+ */
+#define USER_SETTINGS(FLOAT, BOOL, STRING, ENUM)                                                                       \
+    /* Local Time Zone, UTC -12/+14 hours */                                                                           \
+    FLOAT(timeZone, getTimeZone, setTimeZone, DEFAULT_USER_TZ, "Timezone", "%0.2f", -12.0, 14.0)                       \
+    /* Offset in hours from standard time when daylight savings time is in effect */                                   \
+    FLOAT(dstOffset, getDstOffset, setDstOffset, DEFAULT_USER_DSTOFFSET, "DST Offset", "%4.1f", 0.0, 2.0)              \
+    /* Daylight Savings Time enable flag */                                                                            \
+    BOOL(dstEnabled, isDSTEnabled, setDSTEnabled, DEFAULT_USER_DSTENABLE, "DST Enabled")                               \
+    /* WiFi Hostname, 31 character limit */                                                                            \
+    STRING(hostName, 32, getHostName, setHostName, DEFAULT_USER_HOSTNAME, "Hostname")                                  \
+    /* Wifi Antenna Type Selection: Internal(ANT_INTERNAL), External(ANT_EXTERNAL), or Automatic(ANT_AUTO) */          \
+    ENUM(WLanSelectAntenna_TypeDef, antennaType, getAntennaType, setAntennaType, DEFAULT_USER_ANTENNA, "Antenna Type", \
+         antennaNames)
+
 /**************************************************
  * @brief Data Object Structure
  * 
@@ -42,35 +92,42 @@
  * 
  */
 
+//! @cond
+#define USER_SETTING_FLOAT_MEMBER(member, getter, setter, defaultValue, label, format, minValue, maxValue) float member;
+#define USER_SETTING_BOOL_MEMBER(member, getter, setter, defaultValue, label) bool member;
+#define USER_SETTING_STRING_MEMBER(member, size, getter, setter, defaultValue, label) char member[size];
+#define USER_SETTING_ENUM_MEMBER(type, member, getter, setter, defaultValue, label, names) type member;
+//! @endcond
+
 /**
- * @brief User Settings Object
+ * @brief User Settings Object, one member per USER_SETTINGS() entry
  * 
  */
 struct SettingsObject
 {
-    /**
-     * Local Time Zone
-     * 
-     */
-    float timeZone;
-    /** Daylight Savings Time Offset
-     * Offset in hours from standard time when daylight savings time is in effect
-     */
-    float dstOffset;
-    /** Daylight Savings Time enable flag
-     * True = enabled, False = disabled
-     */
-    bool dstEnabled;
-    /** WiFi Hostname
-     * Null-terminated, 31 Character limit
-     */
-    char hostName[32];
-    /** Wifi Antenna Type Selection
-     * For Particle Devices, may be Internal(ANT_INTERNAL), External(ANT_EXTERNAL), or Automatic(ANT_AUTO)
-     */
-    WLanSelectAntenna_TypeDef antennaType;
+    USER_SETTINGS(USER_SETTING_FLOAT_MEMBER, USER_SETTING_BOOL_MEMBER, USER_SETTING_STRING_MEMBER, USER_SETTING_ENUM_MEMBER)
 };
 
+//! @brief Snapshot type tag of SettingsObject (the value earlier versions derived from the type name)
+EEPROM_SNAPSHOT_TAG(SettingsObject, 0xAFCA);
+
+//! @cond
+#define USER_SETTING_FLOAT_ACCESSORS(member, getter, setter, defaultValue, label, format, minValue, maxValue) \
+    float getter() { return _mySettings.member; }                                                             \
+    bool setter(float value) { return _set(_mySettings.member, value); }
+#define USER_SETTING_BOOL_ACCESSORS(member, getter, setter, defaultValue, label) \
+    bool getter() { return _mySettings.member; }                                 \
+    bool setter(bool value) { return _set(_mySettings.member, value); }
+#define USER_SETTING_STRING_ACCESSORS(member, size, getter, setter, defaultValue, label)                          \
+    const char *getter() { return _mySettings.member; }                                                           \
+    bool setter(const char *value, size_t length) { return _setString(_mySettings.member, size, value, length); } \
+    bool setter(const char *value) { return setter(value, strnlen(value, size)); }                                \
+    bool setter(const String &value) { return setter(value.c_str(), value.length()); }
+#define USER_SETTING_ENUM_ACCESSORS(type, member, getter, setter, defaultValue, label, names) \
+    type getter() { return _mySettings.member; }                                              \
+    bool setter(type value) { return _set(_mySettings.member, value); }
+//! @endcond
+
 /*********************************************************************************************************
  * @brief The UserSettings Class
  * 
@@ -81,25 +138,76 @@ struct SettingsObject
  * A checksum is maintained to verify integrity of the EEPROM object image.
  * 
  * @note All access to the individual data items is made via getter/setter functions.
-
+ * 
+ * Each item is described once in USER_SETTINGS(), which generates its member, default, fields[] entry (valid
+ * range and log name) and getter and setter: adding a setting is one table entry.
  */
 class UserSettingsClass : public EEPROM_Class<SettingsObject>
 {
 private:
     /** Working copy of the Data Object that will reside in EEPROM
      */
-    SettingsObject _mySettings = {0, 0, false, "", ANT_INTERNAL};
+    SettingsObject _mySettings = {};
 
     // Private functions for internal use
 
+    /** Validate and store a new item value, writing the object only if the value changed
+     * @param[in] item item within _mySettings
+     * @param[in] value new value
+     * @param[in] size item size
+     * @return bool false if value invalid (setting unchanged), else true
+     */
+    bool _setItem(void *item, const void *value, size_t size);
+
+    template <class T>
+    bool _set(T &item, const T &value) { return _setItem(&item, &value, sizeof(T)); }
+
+    /** Store a new string item, truncated to fit, writing the object only if the value changed
+     * @param[in] item item within _mySettings
+     * @param[in] size item size, including the terminating null
+     * @param[in] value characters of the new value (need not be null-terminated)
+     * @param[in] length number of characters
+     * @return bool false if value truncated, else true
+     */
+    bool _setString(char *item, size_t size, const char *value, size_t length);
+
+    /** Check every field of a snapshot against fields[] before it is imported
+     * @param[in] data SettingsObject bytes, possibly unaligned
+     * @return bool false if any field invalid, else true
+     */
+    bool _validateImage(const uint8_t *data);
+
+    /** Defaults for the boot loader's batched write, also in full (non-sparse) mode
+     * @return const SettingsObject* defaultSettings
+     */
+    const SettingsObject *_defaultObject() { return &defaultSettings; }
+
 public:
+    /** Default settings, held in flash
+     */
+    static const SettingsObject defaultSettings;
+
+    /** Field descriptions, held in flash
+     */
+    static const EEPROM_Field fields[];
+
+    /** Number of entries in fields[]
+     */
+    static const size_t fieldCount;
+
     /** Constructor
      * 
-     *
+     * @param sparse true to store only the settings that differ from defaultSettings (overlay mode).
+     * First-run initialization then writes a few bytes instead of the full object.
+     * Note that switching modes invalidates the stored image, resetting the settings to defaults.
      */
-    UserSettingsClass(): EEPROM_Class()
+    explicit UserSettingsClass(bool sparse = false): EEPROM_Class()
     {
         Log.trace("in UserSettingsClass Constructor.");
+        if (sparse)
+        {
+            setDefaults(defaultSettings);
+        }
     }
     /** Destructor
      *
@@ -116,95 +224,50 @@ public:
      */
     bool begin(uint16_t address);
 
-    /** Reinitializes data object and EEPROM image to defaults
+    /** Assigns the EEPROM address without reading EEPROM, for loading by EEPROM_BootLoader
      * 
      */
-    void reinitialize();
+    void attach(uint16_t address) { EEPROM_Class::attach(address, _mySettings); }
 
-    /** Prints contents of the data items to Serial
-     */
-    void logUserData();
-
-
-
-    /** Get Time Zone
-     * @return int8_t Time Zone value, UTC -12/+14 hours
+    /** Reinitializes data object and EEPROM image to defaults
+     * 
      */
-    float getTimeZone() { return _mySettings.timeZone; }
+    void reinitialize();
 
-    /** Get Daylight Savings Time offset
-     * @return float Offset to standard time when DST is in effect
+    /** Reinitializes to defaults when loaded by EEPROM_BootLoader
+     * @return bool true
      */
-    float getDstOffset() { return _mySettings.dstOffset; }
+    bool loadDefaults()
+    {
+        reinitialize();
+        return true;
+    }
 
-    /** Get Daylight Savings Time enable flag
-     * @return bool true if enable, false if disabled
+    /** Prints contents of the data items to Serial
      */
-    bool isDSTEnabled() { return _mySettings.dstEnabled; }
+    void logUserData();
 
-    /** Get Wifi Hostname.
-     * @return char* to hostname.
-     */
-    char *getHostName() { return _mySettings.hostName; }
-    /** get Antenna Type selection for Particle devices
-     * @return ANT_INTERNAL, ANT_EXTERNAL, or ANT_AUTO
-     */
-    WLanSelectAntenna_TypeDef getAntennaType() { return _mySettings.antennaType; }
+    using EEPROM_Class::importSnapshot;
 
-    /**
-     * @brief Set the Time Zone object
-     * 
-     * @param tz 
+    /** Load all settings from a snapshot with a single EEPROM write
+     * @param[in] buffer snapshot, as produced by exportSnapshot()
+     * @param[in] length snapshot length
+     * @return bool false if snapshot invalid, any setting out of range or the wear budget exhausted (settings unchanged), else true
      */
-    void setTimeZone(float tz)
+    bool importSnapshot(const uint8_t *buffer, size_t length)
     {
-        _mySettings.timeZone = tz;
-        writeObject(_mySettings);
-    }
-    /**
-     * @brief Set the Dst Offset object
-     * 
-     * @param offset 
-     */
-    void setDstOffset(float offset)
-    {
-        _mySettings.dstOffset = offset;
-        writeObject(_mySettings);
-    }
-    /**
-     * @brief Set DST Enable Flag
-     * 
-     * @param flag 
-     */
-    void setDSTEnabled(bool flag)
-    {
-        _mySettings.dstEnabled = flag;
-        writeObject(_mySettings);
+        return importSnapshot(buffer, length, _mySettings);
     }
 
-    /** set Wifi Hostname
-     * @param[in] name string containing new Hostname (31-character limit)
-     * @return bool false if input truncated, else true
-     */
-    bool setHostName(String name);
 
-    /** set Antenna Type selection for Particle devices
-     * @param[in] type ANT_INTERNAL, ANT_EXTERNAL, or ANT_AUTO
-     * @return bool false if input invalid, else true
+
+    /** Getters and setters, one pair per USER_SETTINGS() entry:
+     * - float and enum: getX() returns the value; setX(value) returns false if the value is out of range
+     * - bool: isX() or getX() returns the value; setX(flag) returns true
+     * - string: getX() returns a read-only view of the working copy; setX() takes a null-terminated string,
+     *   a character buffer and length, or a String, and returns false if the value was truncated
+     * 
+     * Every setter writes EEPROM only if the value changed.
      */
-    bool setAntennaType(WLanSelectAntenna_TypeDef type)
-    {
-        if ((type == ANT_INTERNAL) || (type == ANT_EXTERNAL) || (type == ANT_AUTO))
-        {
-            _mySettings.antennaType = type;
-            writeObject(_mySettings);
-            return true;
-        }
-        else
-        {
-            Log.warn("Invalid Antenna Type, setting not changed.");
-            return false;
-        }
-            
-    }
+    USER_SETTINGS(USER_SETTING_FLOAT_ACCESSORS, USER_SETTING_BOOL_ACCESSORS, USER_SETTING_STRING_ACCESSORS, USER_SETTING_ENUM_ACCESSORS)
 };